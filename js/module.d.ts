@@ -342,11 +342,21 @@ export interface ICropInfo {
     readonly top: number;
     readonly bottom: number;
 }
+export interface IIPCBatchArgument {
+    readonly type: 'null' | 'float' | 'double' | 'int32' | 'int64' | 'uint32' | 'uint64' | 'string' | 'binary' | 'reference';
+    readonly value?: number | string | Buffer | ISceneItem | ISource;
+}
+export interface IIPCBatchCall {
+    readonly collection: string;
+    readonly func: string;
+    readonly args?: IIPCBatchArgument[];
+}
 export interface IIPC {
     setServerPath(binaryPath: string, workingDirectoryPath?: string): void;
     connect(uri: string): void;
     host(uri: string): EIPCError;
     disconnect(): void;
+    batch(calls: IIPCBatchCall[]): (any[] | Error)[];
 }
 export interface IGlobal {
     startup(locale: string, path?: string): void;
@@ -447,6 +457,7 @@ export interface IFilter extends ISource {
 }
 export interface IInputFactory extends IFactoryTypes {
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): IInput;
+    createAsync(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): Promise<IInput>;
     createPrivate(id: string, name: string, settings?: ISettings): IInput;
     fromName(name: string): IInput;
     getPublicSources(): IInput[];
@@ -540,6 +551,15 @@ export interface IScene extends ISource {
     findItem(id: string | number): ISceneItem;
     getItemAtIdx(idx: number): ISceneItem;
     getItems(): ISceneItem[];
+    getItemsAsync(): Promise<ISceneItem[]>;
+    applyTransforms(transforms: ISceneItemTransform[]): void;
+}
+export interface ISceneItemTransform {
+    item: ISceneItem;
+    position?: IVec2;
+    scale?: IVec2;
+    rotation?: number;
+    crop?: ICropInfo;
 }
 export interface ISceneItem {
     readonly source: IInput;
@@ -589,6 +609,7 @@ export interface IConfigurable {
     readonly settings: ISettings;
 }
 export interface ISource extends IConfigurable, IReleasable {
+    getPropertiesAsync(): Promise<IProperties>;
     remove(): void;
     save(): void;
     readonly status: number;
@@ -618,6 +639,7 @@ export interface IVolmeterFactory {
 }
 export interface IVolmeter {
     updateInterval: number;
+    readonly id: number;
     destroy(): void;
     attach(source: IInput): void;
     detach(): void;
@@ -798,6 +820,8 @@ export interface IStreaming {
     signalHandler: (signal: EOutputSignal) => void;
     start(): void;
     stop(force?: boolean): void;
+    startAsync(): Promise<void>;
+    stopAsync(force?: boolean): Promise<void>;
 }
 export interface EOutputSignal {
     type: string;
@@ -847,6 +871,8 @@ export interface IRecording extends IFileOutput {
     signalHandler: (signal: EOutputSignal) => void;
     start(): void;
     stop(force?: boolean): void;
+    startAsync(): Promise<void>;
+    stopAsync(force?: boolean): Promise<void>;
     splitFile(): void;
 }
 export interface ISimpleRecording extends IRecording {
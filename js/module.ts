@@ -446,6 +446,25 @@ export interface ICropInfo {
     readonly bottom: number;
 }
 
+/**
+ * Typed argument of a batched IPC call. The type must match the
+ * signature of the server function exactly. A 'reference' is a scene
+ * item or source object, passed to the server as its UInt64 id.
+ */
+export interface IIPCBatchArgument {
+    readonly type: 'null' | 'float' | 'double' | 'int32' | 'int64' | 'uint32' | 'uint64' | 'string' | 'binary' | 'reference';
+    readonly value?: number | string | Buffer | ISceneItem | ISource;
+}
+
+/**
+ * A single server call inside of a batch.
+ */
+export interface IIPCBatchCall {
+    readonly collection: string;
+    readonly func: string;
+    readonly args?: IIPCBatchArgument[];
+}
+
 /**
  * Namespace representing the global libobs functionality
  */
@@ -482,6 +501,17 @@ export interface IIPC {
      * Disconnect from a server.
      */
 	disconnect(): void;
+
+    /**
+     * Executes several server calls in a single round-trip. Calls are run
+     * in order and a failing call does not abort the rest of the batch.
+     * @param calls - Calls to execute
+     * @returns - One entry per call: the raw reply values (error code first),
+     *            or an Error if the server could not dispatch the call.
+	 * @throws TypeError if a call or argument is malformed.
+	 * @throws Error if the batch could not be sent.
+     */
+	batch(calls: IIPCBatchCall[]): (any[] | Error)[];
 }
 
 export interface IGlobal {
@@ -766,6 +796,12 @@ export interface IInputFactory extends IFactoryTypes {
      */
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): IInput;
 
+    /**
+     * Same as {@link create}, without blocking while the server creates the source
+     * @returns - Promise resolved with the instance
+     */
+    createAsync(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): Promise<IInput>;
+
     /**
      * Create a new instance of an ObsInput that's private
      * Private in this context means any function that returns an
@@ -1038,6 +1074,27 @@ export interface IScene extends ISource {
      * @returns - The array of item instances
      */
     getItems(): ISceneItem[];
+
+    /**
+     * Same as {@link getItems}, without blocking while the server lists the items
+     * @returns - Promise resolved with the array of item instances
+     */
+    getItemsAsync(): Promise<ISceneItem[]>;
+
+    /**
+     * Update the transforms of several items of the scene at once. The
+     * changes are applied together so no partial update is ever rendered.
+     * @param transforms - Items and the fields to change for each of them
+     */
+    applyTransforms(transforms: ISceneItemTransform[]): void;
+}
+
+export interface ISceneItemTransform {
+    item: ISceneItem,
+    position?: IVec2,
+    scale?: IVec2,
+    rotation?: number,
+    crop?: ICropInfo
 }
 
 /**
@@ -1224,6 +1281,12 @@ export interface IConfigurable {
  * Base class for Filter, Transition, Scene, and Input
  */
 export interface ISource extends IConfigurable, IReleasable {
+    /**
+     * Same as {@link properties}, without blocking while the server builds them
+     * @returns - Promise resolved with the properties of the source
+     */
+    getPropertiesAsync(): Promise<IProperties>;
+
     /**
      * Send remove signal to other holders of the current reference.
      */
@@ -1356,6 +1419,13 @@ export interface IVolmeter {
      */
     updateInterval: number;
 
+    /**
+     * Server id of the volmeter, as written in the frames passed to
+     * NodeObs.RegisterVolmeterBufferCallback: the low and high 32 bits are the
+     * first two words of each frame in its Uint32Array.
+     */
+    readonly id: number;
+
     /**
      * Destroy the volmeter object object
      */
@@ -1685,6 +1755,10 @@ export interface IStreaming {
     signalHandler: (signal: EOutputSignal) => void,
     start(): void,
     stop(force?: boolean): void,
+    /** Same as start, resolved once the server started the output */
+    startAsync(): Promise<void>,
+    /** Same as stop, resolved once the server processed the request */
+    stopAsync(force?: boolean): Promise<void>,
 }
 
 export interface EOutputSignal {
@@ -1741,6 +1815,10 @@ export interface IRecording extends IFileOutput {
     signalHandler: (signal: EOutputSignal) => void,
     start(): void,
     stop(force?: boolean): void,
+    /** Same as start, resolved once the server started the output */
+    startAsync(): Promise<void>,
+    /** Same as stop, resolved once the server processed the request */
+    stopAsync(force?: boolean): Promise<void>,
     splitFile(): void
 }
 
@@ -53,6 +53,8 @@ Napi::Object osn::AdvancedRecording::Init(Napi::Env env, Napi::Object exports)
 
 		 InstanceMethod("start", &osn::AdvancedRecording::Start),
 		 InstanceMethod("stop", &osn::AdvancedRecording::Stop),
+		 InstanceMethod("startAsync", &osn::AdvancedRecording::StartAsync),
+		 InstanceMethod("stopAsync", &osn::AdvancedRecording::StopAsync),
 		 InstanceMethod("splitFile", &osn::AdvancedRecording::SplitFile),
 
 		 StaticAccessor("legacySettings", &osn::AdvancedRecording::GetLegacySettings, &osn::AdvancedRecording::SetLegacySettings),
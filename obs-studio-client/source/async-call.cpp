@@ -0,0 +1,153 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#include "async-call.hpp"
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "call-stats.hpp"
+#include "call-trace.hpp"
+#include "controller.hpp"
+
+struct AsyncJob {
+	std::string collection;
+	std::string function;
+	std::vector<ipc::value> args;
+	std::vector<ipc::value> response;
+	async::Resolver resolver;
+	Napi::Promise::Deferred deferred;
+	Napi::ThreadSafeFunction settle;
+	bool timed = false;
+	callstats::clock::time_point queued;
+	callstats::clock::time_point started;
+	callstats::clock::time_point replied;
+
+	AsyncJob(Napi::Env env) : deferred(Napi::Promise::Deferred::New(env)) {}
+};
+
+static std::mutex queue_mtx;
+static std::condition_variable queue_cv;
+static std::list<AsyncJob *> queue_jobs;
+static std::thread queue_thread;
+static bool queue_stop = false;
+
+static void Settle(Napi::Env env, Napi::Function, AsyncJob *job)
+{
+	std::unique_ptr<AsyncJob> owner(job);
+	if (env == nullptr)
+		return;
+
+	Napi::HandleScope scope(env);
+	Napi::Value value = job->resolver(env, job->response);
+	if (env.IsExceptionPending())
+		job->deferred.Reject(env.GetAndClearPendingException().Value());
+	else
+		job->deferred.Resolve(value.IsEmpty() ? env.Undefined() : value);
+
+	if (job->timed) {
+		callstats::clock::time_point end = callstats::clock::now();
+		callstats::Sample sample;
+		sample.wall = end - job->queued;
+		sample.queue = job->started - job->queued;
+		sample.wait = job->replied - job->started;
+		sample.convert = end - job->replied;
+		callstats::Record(job->collection, job->function, sample);
+	}
+}
+
+static void Complete(AsyncJob *job)
+{
+	Napi::ThreadSafeFunction settle = job->settle;
+	if (settle.BlockingCall(job, Settle) != napi_ok)
+		delete job;
+	settle.Release();
+}
+
+static void Worker()
+{
+	// The server runs the calls of a connection one at a time, a connection
+	// of its own would let them race with the calls of the JS thread.
+	std::shared_ptr<ipc::client> conn = Controller::GetInstance().GetConnection();
+
+	std::unique_lock<std::mutex> ulock(queue_mtx);
+	while (true) {
+		queue_cv.wait(ulock, []() { return queue_stop || !queue_jobs.empty(); });
+		if (queue_stop)
+			break;
+
+		AsyncJob *job = queue_jobs.front();
+		queue_jobs.pop_front();
+		ulock.unlock();
+
+		calltrace::Ticket ticket = calltrace::Begin();
+		job->started = ticket.start;
+		if (conn)
+			job->response = conn->call_synchronous_helper(job->collection, job->function, job->args);
+		job->replied = callstats::clock::now();
+		calltrace::Record(ticket, job->replied, job->collection, job->function, job->args, job->response);
+		Complete(job);
+
+		ulock.lock();
+	}
+}
+
+Napi::Value async::Call(Napi::Env env, const std::string &collection, const std::string &function, std::vector<ipc::value> &&args, Resolver resolver)
+{
+	AsyncJob *job = new AsyncJob(env);
+	job->collection = collection;
+	job->function = function;
+	job->args = std::move(args);
+	job->resolver = resolver;
+	job->timed = callstats::IsEnabled();
+	job->queued = callstats::clock::now();
+	job->settle = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo &) {}), "AsyncCall", 0, 1);
+	Napi::Promise promise = job->deferred.Promise();
+
+	std::unique_lock<std::mutex> ulock(queue_mtx);
+	if (!queue_thread.joinable()) {
+		queue_stop = false;
+		queue_thread = std::thread(Worker);
+	}
+	queue_jobs.push_back(job);
+	queue_cv.notify_one();
+
+	return promise;
+}
+
+void async::Stop()
+{
+	std::list<AsyncJob *> jobs;
+	std::thread thread;
+	{
+		std::unique_lock<std::mutex> ulock(queue_mtx);
+		queue_stop = true;
+		jobs.swap(queue_jobs);
+		thread.swap(queue_thread);
+		queue_cv.notify_all();
+	}
+
+	if (thread.joinable())
+		thread.join();
+
+	// Settled with an empty reply, which rejects them.
+	for (auto job : jobs)
+		Complete(job);
+}
@@ -0,0 +1,42 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include <napi.h>
+#include "ipc-client.hpp"
+
+// Runs server calls on a client I/O thread and settles a Promise on the JS
+// thread once the server replied, so slow calls do not block the main thread.
+// Calls go through the shared connection, as server handlers are not safe to
+// run concurrently, and complete one after the other in the order they were
+// made.
+namespace async {
+// Converts the reply on the JS thread. Errors thrown with
+// ThrowAsJavaScriptException, such as the ones of ValidateResponse, reject
+// the Promise.
+typedef std::function<Napi::Value(Napi::Env env, std::vector<ipc::value> &response)> Resolver;
+
+Napi::Value Call(Napi::Env env, const std::string &collection, const std::string &function, std::vector<ipc::value> &&args, Resolver resolver);
+
+// Joins the I/O thread. Calls that were not sent are rejected.
+void Stop();
+} // namespace async
@@ -17,3 +17,121 @@
 ******************************************************************************/
 
 #include "cache-manager.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include "event-channel.hpp"
+
+struct SourceInvalidation {
+	uint64_t id;
+	uint64_t version;
+	uint32_t what;
+};
+
+// Filled on the event channel thread, applied on the JS thread.
+static std::mutex invalidations_mtx;
+static std::vector<SourceInvalidation> invalidations;
+static std::atomic<bool> invalidations_pending(false);
+
+static void on_source_invalidations(const std::vector<const EventChannel::Event *> &events)
+{
+	std::unique_lock<std::mutex> ulock(invalidations_mtx);
+	for (auto event : events) {
+		if (event->values.size() < 3)
+			continue;
+		invalidations.push_back({event->values[0].value_union.ui64, event->values[1].value_union.ui64, event->values[2].value_union.ui32});
+	}
+	invalidations_pending = !invalidations.empty();
+}
+
+static inline void invalidate(uint64_t &cachedVersion, bool &changed, uint64_t version)
+{
+	if (version <= cachedVersion)
+		return;
+	cachedVersion = version;
+	changed = true;
+}
+
+void cache::ApplySourceInvalidations()
+{
+	if (!invalidations_pending)
+		return;
+
+	std::vector<SourceInvalidation> pending;
+	{
+		std::unique_lock<std::mutex> ulock(invalidations_mtx);
+		pending.swap(invalidations);
+		invalidations_pending = false;
+	}
+
+	auto &sources = CacheManager<SourceDataInfo *>::getInstance();
+	for (auto &item : pending) {
+		std::shared_ptr<SourceDataInfo> sdi = sources.Peek(item.id);
+		if (!sdi)
+			continue;
+
+		if (item.what & osn::SourceSettings)
+			invalidate(sdi->settingsVersion, sdi->settingsChanged, item.version);
+		if (item.what & osn::SourceProperties)
+			invalidate(sdi->propertiesVersion, sdi->propertiesChanged, item.version);
+		if (item.what & osn::SourceFilters)
+			invalidate(sdi->filtersVersion, sdi->filtersOrderChanged, item.version);
+	}
+}
+
+void cache::SubscribeSourceInvalidations()
+{
+	EventChannel::GetInstance().Subscribe(osn::EventType::SourceInvalidated, &invalidations, on_source_invalidations);
+}
+
+void cache::UnsubscribeSourceInvalidations()
+{
+	EventChannel::GetInstance().Unsubscribe(osn::EventType::SourceInvalidated, &invalidations);
+
+	std::unique_lock<std::mutex> ulock(invalidations_mtx);
+	invalidations.clear();
+	invalidations_pending = false;
+}
+
+template<class V> static Napi::Object StatisticsToJS(Napi::Env env, const typename CacheStore<V>::Statistics &stats)
+{
+	Napi::Object object = Napi::Object::New(env);
+	object.Set("hits", Napi::Number::New(env, double(stats.hits)));
+	object.Set("misses", Napi::Number::New(env, double(stats.misses)));
+	object.Set("evictions", Napi::Number::New(env, double(stats.evictions)));
+	object.Set("size", Napi::Number::New(env, double(stats.size)));
+	object.Set("capacity", Napi::Number::New(env, double(stats.capacity)));
+	return object;
+}
+
+Napi::Value cache::GetStatistics(const Napi::CallbackInfo &info)
+{
+	Napi::Object result = Napi::Object::New(info.Env());
+	result.Set("scenes", StatisticsToJS<SceneInfo>(info.Env(), CacheManager<SceneInfo *>::getInstance().GetStatistics()));
+	result.Set("sources", StatisticsToJS<SourceDataInfo>(info.Env(), CacheManager<SourceDataInfo *>::getInstance().GetStatistics()));
+	result.Set("sceneItems", StatisticsToJS<SceneItemData>(info.Env(), CacheManager<SceneItemData *>::getInstance().GetStatistics()));
+	return result;
+}
+
+Napi::Value cache::SetCapacity(const Napi::CallbackInfo &info)
+{
+	if (info.Length() != 2 || !info[0].IsString() || !info[1].IsNumber()) {
+		Napi::TypeError::New(info.Env(), "Invalid arguments, usage: SetCacheCapacity(<string> cache, <number> entries).")
+			.ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	std::string name = info[0].ToString().Utf8Value();
+	size_t capacity = size_t(std::max<int64_t>(info[1].ToNumber().Int64Value(), 0));
+
+	if (name == "scenes") {
+		CacheManager<SceneInfo *>::getInstance().SetCapacity(capacity);
+	} else if (name == "sources") {
+		CacheManager<SourceDataInfo *>::getInstance().SetCapacity(capacity);
+	} else if (name == "sceneItems") {
+		CacheManager<SceneItemData *>::getInstance().SetCapacity(capacity);
+	} else {
+		Napi::Error::New(info.Env(), "Unknown cache '" + name + "'.").ThrowAsJavaScriptException();
+	}
+	return info.Env().Undefined();
+}
@@ -16,6 +16,12 @@
 
 ******************************************************************************/
 
+#pragma once
+#include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 #include "utility-v8.hpp"
 #include "properties.hpp"
 
@@ -37,13 +43,18 @@ struct SourceDataInfo {
 	std::string setting = "";
 	bool settingsChanged = true;
 
+	// Versions of the cached data, see osn::EventType::SourceInvalidated.
+	uint64_t settingsVersion = 0;
+	uint64_t propertiesVersion = 0;
+	uint64_t filtersVersion = 0;
+
 	osn::property_map_t properties;
 	bool propertiesChanged = true;
 
 	uint32_t audioMixers = UINT32_MAX;
 	bool audioMixersChanged = true;
 
-	std::vector<uint64_t> *filters = new std::vector<uint64_t>();
+	std::vector<uint64_t> filters;
 	bool filtersOrderChanged = true;
 
 	uint32_t deinterlaceMode = 0;
@@ -53,6 +64,12 @@ struct SourceDataInfo {
 	bool deinterlaceFieldOrderChanged = true;
 };
 
+namespace cache {
+// Applies the source invalidations received from the server, called before
+// cached source data is read.
+void ApplySourceInvalidations();
+} // namespace cache
+
 struct SceneItemData {
 	int64_t obs_itemId = -1;
 	uint64_t scene_id = UINT64_MAX;
@@ -97,110 +114,172 @@ struct SceneItemData {
 	bool blendingMethodChanged = true;
 };
 
-template<class T> class CacheManager {
+// Owning cache of per-object data mirrored from the server, indexed by id and
+// optionally by name. Entries are kept in least recently used order so the
+// cache can be bounded, a capacity of 0 leaves it unbounded. Retrieve returns
+// nullptr for entries that are not cached, including evicted ones, and
+// callers fall back to the server. Values are shared with callers, so an
+// entry evicted or removed while a caller still holds it stays alive until
+// the caller drops it. Only used from the JS thread.
+template<class V> class CacheStore {
 public:
-	static CacheManager &getInstance()
-	{
-		static CacheManager instance;
-		return instance;
-	}
+	struct Statistics {
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t evictions = 0;
+		size_t size = 0;
+		size_t capacity = 0;
+	};
 
 private:
-	CacheManager(){};
+	struct Entry {
+		uint64_t id;
+		std::string name;
+		std::shared_ptr<V> value;
+	};
+	typedef typename std::list<Entry>::iterator entry_t;
 
-public:
-	CacheManager(CacheManager const &) = delete;
-	void operator=(CacheManager const &) = delete;
+	std::list<Entry> entries;
+	std::unordered_map<uint64_t, entry_t> byId;
+	std::unordered_map<std::string, uint64_t> byName;
+	size_t capacity = 0;
+	Statistics stats;
 
-private:
-	std::map<std::string, SceneInfo *> scenesByName;
-	std::map<uint64_t, SceneInfo *> scenesById;
-	std::map<std::string, SourceDataInfo *> sourcesByName;
-	std::map<uint64_t, SourceDataInfo *> sourcesById;
-	std::map<uint64_t, SceneItemData *> itemsData;
+	void Touch(entry_t it) { entries.splice(entries.begin(), entries, it); }
 
-public:
-	void Store(uint64_t id, std::string name, SceneInfo *si)
+	void Erase(entry_t it)
+	{
+		if (it->name.size() > 0) {
+			auto name = byName.find(it->name);
+			if (name != byName.end() && name->second == it->id)
+				byName.erase(name);
+		}
+		byId.erase(it->id);
+		entries.erase(it);
+	}
+
+	void Evict()
 	{
-		si->name = name;
-		scenesByName.erase(name);
-		scenesById.erase(id);
-		scenesByName.emplace(name, si);
-		scenesById.emplace(id, si);
+		while (capacity > 0 && entries.size() > capacity) {
+			Erase(std::prev(entries.end()));
+			stats.evictions++;
+		}
 	}
-	void Store(uint64_t id, std::string name, SourceDataInfo *sdi)
+
+	void Insert(uint64_t id, const std::string &name, std::shared_ptr<V> value)
 	{
-		sdi->name = name;
-		sourcesByName.erase(name);
-		sourcesById.erase(id);
-		sourcesByName.emplace(name, sdi);
-		sourcesById.emplace(id, sdi);
+		auto it = byId.find(id);
+		if (it != byId.end())
+			Erase(it->second);
+
+		entries.push_front({id, name, std::move(value)});
+		byId[id] = entries.begin();
+		if (name.size() > 0)
+			byName[name] = id;
+		Evict();
 	}
-	void Store(uint64_t id, SceneItemData *sid)
+
+	// Storing the cached object again only refreshes its name.
+	std::shared_ptr<V> Adopt(uint64_t id, V *value)
 	{
-		itemsData.erase(id);
-		itemsData.emplace(id, sid);
+		auto it = byId.find(id);
+		if (it != byId.end() && it->second->value.get() == value)
+			return it->second->value;
+		return std::shared_ptr<V>(value);
 	}
-	T Retrieve(uint64_t id)
+
+public:
+	// Takes ownership of the value.
+	void Store(uint64_t id, V *value) { Insert(id, "", Adopt(id, value)); }
+	void Store(uint64_t id, const std::string &name, V *value)
 	{
-		if (id != UINT64_MAX) {
-			if (typeid(T) == typeid(SceneInfo *)) {
-				auto it = scenesById.find(id);
-				if (it != scenesById.end()) {
-					return (T)it->second;
-				}
-			} else if (typeid(T) == typeid(SourceDataInfo *)) {
-				auto it = sourcesById.find(id);
-				if (it != sourcesById.end()) {
-					return (T)it->second;
-				}
-			} else if (typeid(T) == typeid(SceneItemData *)) {
-				auto it = itemsData.find(id);
-				if (it != itemsData.end()) {
-					return (T)it->second;
-				}
-			}
+		value->name = name;
+		Insert(id, name, Adopt(id, value));
+	}
+	void Store(uint64_t id, std::shared_ptr<V> value) { Insert(id, "", std::move(value)); }
+
+	std::shared_ptr<V> Retrieve(uint64_t id)
+	{
+		if (id == UINT64_MAX)
+			return nullptr;
+
+		if constexpr (std::is_same<V, SourceDataInfo>::value)
+			cache::ApplySourceInvalidations();
+
+		auto it = byId.find(id);
+		if (it == byId.end()) {
+			stats.misses++;
+			return nullptr;
 		}
-		return nullptr;
+		stats.hits++;
+		Touch(it->second);
+		return it->second->value;
 	}
-	T Retrieve(const std::string &name)
+	std::shared_ptr<V> Retrieve(const std::string &name)
 	{
-		if (name.size() > 0) {
-			if (typeid(T) == typeid(SceneInfo *)) {
-				auto it = scenesByName.find(name);
-				if (it != scenesByName.end()) {
-					return (T)it->second;
-				}
-			} else if (typeid(T) == typeid(SourceDataInfo *)) {
-				auto it = sourcesByName.find(name);
-				if (it != sourcesByName.end()) {
-					return (T)it->second;
-				}
-			}
+		if (name.size() == 0)
+			return nullptr;
+
+		auto it = byName.find(name);
+		if (it == byName.end()) {
+			stats.misses++;
+			return nullptr;
 		}
-		return nullptr;
+		return Retrieve(it->second);
 	}
+
+	// Lookup that neither counts nor reorders entries.
+	std::shared_ptr<V> Peek(uint64_t id)
+	{
+		auto it = byId.find(id);
+		return it != byId.end() ? it->second->value : nullptr;
+	}
+
 	void Remove(uint64_t id)
 	{
-		if (id != UINT64_MAX) {
-			if (typeid(T) == typeid(SceneInfo *)) {
-				auto it = scenesById.find(id);
-				if (it != scenesById.end()) {
-					scenesByName.erase(it->second->name);
-					scenesById.erase(id);
-				}
-			} else if (typeid(T) == typeid(SourceDataInfo *)) {
-				auto it = sourcesById.find(id);
-				if (it != sourcesById.end()) {
-					sourcesByName.erase(it->second->name);
-					sourcesById.erase(id);
-				}
-			} else if (typeid(T) == typeid(SceneItemData *)) {
-				auto it = itemsData.find(id);
-				if (it != itemsData.end()) {
-					itemsData.erase(id);
-				}
-			}
-		}
+		auto it = byId.find(id);
+		if (it != byId.end())
+			Erase(it->second);
 	}
-};
\ No newline at end of file
+
+	void SetCapacity(size_t max_entries)
+	{
+		capacity = max_entries;
+		Evict();
+	}
+
+	Statistics GetStatistics()
+	{
+		Statistics result = stats;
+		result.size = entries.size();
+		result.capacity = capacity;
+		return result;
+	}
+};
+
+template<class T> class CacheManager;
+
+template<class V> class CacheManager<V *> : public CacheStore<V> {
+public:
+	static CacheManager &getInstance()
+	{
+		static CacheManager instance;
+		return instance;
+	}
+
+private:
+	CacheManager(){};
+
+public:
+	CacheManager(CacheManager const &) = delete;
+	void operator=(CacheManager const &) = delete;
+};
+
+namespace cache {
+Napi::Value GetStatistics(const Napi::CallbackInfo &info);
+Napi::Value SetCapacity(const Napi::CallbackInfo &info);
+
+// Starts or stops listening to source invalidations pushed by the server.
+void SubscribeSourceInvalidations();
+void UnsubscribeSourceInvalidations();
+} // namespace cache
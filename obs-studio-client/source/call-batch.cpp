@@ -0,0 +1,237 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "call-batch.hpp"
+#include "controller.hpp"
+#include "filter.hpp"
+#include "input.hpp"
+#include "osn-error.hpp"
+#include "scene.hpp"
+#include "sceneitem.hpp"
+#include "transition.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+
+size_t CallBatch::Add(const std::string &collection, const std::string &function, const std::vector<ipc::value> &args)
+{
+	calls.push_back({collection, function, args});
+	return calls.size() - 1;
+}
+
+size_t CallBatch::Size() const
+{
+	return calls.size();
+}
+
+void CallBatch::Clear()
+{
+	calls.clear();
+}
+
+bool CallBatch::Execute(callstats::Connection &conn, std::vector<osn::batch::Result> &results, std::string &error)
+{
+	results.clear();
+	if (calls.empty())
+		return true;
+
+	std::vector<char> buffer;
+	osn::batch::serialize_calls(calls, buffer);
+	calls.clear();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Batch", "Call", {ipc::value(buffer)});
+	if (response.size() == 0) {
+		error = "Failed to make IPC call, verify IPC status.";
+		return false;
+	}
+	if (response[0].type == ipc::type::Null) {
+		error = response[0].value_str;
+		return false;
+	}
+	if ((ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok || response.size() < 2) {
+		error = response.size() > 1 ? response[1].value_str : "Batch call failed.";
+		return false;
+	}
+	if (!osn::batch::deserialize_results(response[1].value_bin, results)) {
+		error = "Malformed batch reply.";
+		return false;
+	}
+	return true;
+}
+
+static bool ReferenceFromObject(const Napi::Value &value, uint64_t &uid)
+{
+	if (!value.IsObject())
+		return false;
+
+	Napi::Object object = value.ToObject();
+	if (object.InstanceOf(osn::SceneItem::constructor.Value())) {
+		uid = osn::SceneItem::Unwrap(object)->itemId;
+	} else if (object.InstanceOf(osn::Input::constructor.Value())) {
+		uid = osn::Input::Unwrap(object)->sourceId;
+	} else if (object.InstanceOf(osn::Scene::constructor.Value())) {
+		uid = osn::Scene::Unwrap(object)->sourceId;
+	} else if (object.InstanceOf(osn::Filter::constructor.Value())) {
+		uid = osn::Filter::Unwrap(object)->sourceId;
+	} else if (object.InstanceOf(osn::Transition::constructor.Value())) {
+		uid = osn::Transition::Unwrap(object)->sourceId;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static bool ArgumentFromValue(const Napi::Value &value, ipc::value &arg)
+{
+	// Arguments must be typed explicitly since the server resolves functions
+	// by their exact signature: {type: 'uint64', value: 1}.
+	if (!value.IsObject())
+		return false;
+
+	Napi::Object object = value.ToObject();
+	if (!object.Get("type").IsString())
+		return false;
+
+	std::string type = object.Get("type").ToString().Utf8Value();
+	Napi::Value raw = object.Get("value");
+
+	if (type == "null") {
+		arg = ipc::value();
+		arg.type = ipc::type::Null;
+	} else if (type == "float") {
+		arg = ipc::value(raw.ToNumber().FloatValue());
+	} else if (type == "double") {
+		arg = ipc::value(raw.ToNumber().DoubleValue());
+	} else if (type == "int32") {
+		arg = ipc::value(raw.ToNumber().Int32Value());
+	} else if (type == "int64") {
+		arg = ipc::value(raw.ToNumber().Int64Value());
+	} else if (type == "uint32") {
+		arg = ipc::value(raw.ToNumber().Uint32Value());
+	} else if (type == "uint64") {
+		arg = ipc::value((uint64_t)raw.ToNumber().Int64Value());
+	} else if (type == "reference") {
+		// Scene items and sources are addressed by their server id, which
+		// is not visible from JS.
+		uint64_t uid = UINT64_MAX;
+		if (!ReferenceFromObject(raw, uid))
+			return false;
+		arg = ipc::value(uid);
+	} else if (type == "string") {
+		arg = ipc::value(raw.ToString().Utf8Value());
+	} else if (type == "binary") {
+		if (!raw.IsBuffer())
+			return false;
+		Napi::Buffer<char> buffer = raw.As<Napi::Buffer<char>>();
+		arg = ipc::value(std::vector<char>(buffer.Data(), buffer.Data() + buffer.Length()));
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static Napi::Value ValueToJS(Napi::Env env, const ipc::value &value)
+{
+	switch (value.type) {
+	case ipc::type::Float:
+		return Napi::Number::New(env, value.value_union.fp32);
+	case ipc::type::Double:
+		return Napi::Number::New(env, value.value_union.fp64);
+	case ipc::type::Int32:
+		return Napi::Number::New(env, value.value_union.i32);
+	case ipc::type::Int64:
+		return Napi::Number::New(env, value.value_union.i64);
+	case ipc::type::UInt32:
+		return Napi::Number::New(env, value.value_union.ui32);
+	case ipc::type::UInt64:
+		return Napi::Number::New(env, value.value_union.ui64);
+	case ipc::type::String:
+		return Napi::String::New(env, value.value_str);
+	case ipc::type::Binary:
+		return Napi::Buffer<char>::Copy(env, value.value_bin.data(), value.value_bin.size());
+	default:
+		return env.Null();
+	}
+}
+
+Napi::Value CallBatch::JSExecute(const Napi::CallbackInfo &info)
+{
+	if (info.Length() != 1 || !info[0].IsArray()) {
+		Napi::Error::New(info.Env(), "Invalid arguments, usage: batch(<array> calls).").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	CallBatch batch;
+	Napi::Array calls = info[0].As<Napi::Array>();
+	for (uint32_t idx = 0; idx < calls.Length(); idx++) {
+		Napi::Value entry = calls.Get(idx);
+		if (!entry.IsObject()) {
+			Napi::TypeError::New(info.Env(), "Batch call " + std::to_string(idx) + " must be an object.").ThrowAsJavaScriptException();
+			return info.Env().Undefined();
+		}
+
+		Napi::Object call = entry.ToObject();
+		if (!call.Get("collection").IsString() || !call.Get("func").IsString()) {
+			Napi::TypeError::New(info.Env(), "Batch call " + std::to_string(idx) + " is missing 'collection' or 'func'.")
+				.ThrowAsJavaScriptException();
+			return info.Env().Undefined();
+		}
+
+		std::vector<ipc::value> args;
+		if (call.Get("args").IsArray()) {
+			Napi::Array jsArgs = call.Get("args").As<Napi::Array>();
+			args.resize(jsArgs.Length());
+			for (uint32_t arg = 0; arg < jsArgs.Length(); arg++) {
+				if (!ArgumentFromValue(jsArgs.Get(arg), args[arg])) {
+					Napi::TypeError::New(info.Env(), "Batch call " + std::to_string(idx) + " has an invalid argument " + std::to_string(arg) + ".")
+						.ThrowAsJavaScriptException();
+					return info.Env().Undefined();
+				}
+			}
+		}
+
+		batch.Add(call.Get("collection").ToString().Utf8Value(), call.Get("func").ToString().Utf8Value(), args);
+	}
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<osn::batch::Result> results;
+	std::string error;
+	if (!batch.Execute(conn, results, error)) {
+		Napi::Error::New(info.Env(), error).ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	// Each entry is the raw reply of the call (error code first), or an Error
+	// if the server could not dispatch it.
+	Napi::Array array = Napi::Array::New(info.Env(), results.size());
+	for (size_t idx = 0; idx < results.size(); idx++) {
+		const osn::batch::Result &result = results[idx];
+		if (result.size() == 1 && result[0].type == ipc::type::Null) {
+			array.Set(uint32_t(idx), Napi::Error::New(info.Env(), result[0].value_str).Value());
+			continue;
+		}
+
+		Napi::Array values = Napi::Array::New(info.Env(), result.size());
+		for (size_t value = 0; value < result.size(); value++)
+			values.Set(uint32_t(value), ValueToJS(info.Env(), result[value]));
+		array.Set(uint32_t(idx), values);
+	}
+	return array;
+}
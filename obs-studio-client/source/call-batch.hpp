@@ -0,0 +1,44 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <napi.h>
+#include "ipc-client.hpp"
+#include "call-stats.hpp"
+#include "osn-batch.hpp"
+
+// Collects server calls and sends them through the "Batch" collection in a
+// single round-trip. Results are returned in the order the calls were added.
+// The client statistics and traces see the batch as one Batch::Call, while
+// the server profiles each call of the batch on its own.
+class CallBatch {
+public:
+	size_t Add(const std::string &collection, const std::string &function, const std::vector<ipc::value> &args);
+	size_t Size() const;
+	void Clear();
+
+	bool Execute(callstats::Connection &conn, std::vector<osn::batch::Result> &results, std::string &error);
+
+	static Napi::Value JSExecute(const Napi::CallbackInfo &info);
+
+private:
+	std::vector<osn::batch::Call> calls;
+};
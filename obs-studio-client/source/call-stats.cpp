@@ -0,0 +1,167 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "call-stats.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include "call-trace.hpp"
+
+struct CallStatistics {
+	uint64_t calls = 0;
+	uint64_t asyncCalls = 0;
+	uint64_t wallUs = 0;
+	uint64_t maxWallUs = 0;
+	uint64_t queueUs = 0;
+	uint64_t waitUs = 0;
+	uint64_t maxWaitUs = 0;
+	uint64_t convertUs = 0;
+};
+
+static std::atomic<bool> stats_enabled(false);
+static std::mutex stats_mtx;
+static std::unordered_map<std::string, CallStatistics> stats_calls;
+
+static inline uint64_t Microseconds(std::chrono::nanoseconds duration)
+{
+	return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+bool callstats::IsEnabled()
+{
+	return stats_enabled;
+}
+
+void callstats::Record(const std::string &collection, const std::string &function, const Sample &sample)
+{
+	uint64_t wall = Microseconds(sample.wall);
+	uint64_t wait = Microseconds(sample.wait);
+
+	std::unique_lock<std::mutex> ulock(stats_mtx);
+	CallStatistics &stats = stats_calls[collection + "::" + function];
+	stats.calls++;
+	stats.wallUs += wall;
+	stats.maxWallUs = std::max(stats.maxWallUs, wall);
+	stats.queueUs += Microseconds(sample.queue);
+	stats.waitUs += wait;
+	stats.maxWaitUs = std::max(stats.maxWaitUs, wait);
+	stats.convertUs += Microseconds(sample.convert);
+}
+
+void callstats::RecordAsync(const std::string &collection, const std::string &function)
+{
+	std::unique_lock<std::mutex> ulock(stats_mtx);
+	stats_calls[collection + "::" + function].asyncCalls++;
+}
+
+callstats::Connection::Connection(std::shared_ptr<ipc::client> client) : m_client(client), m_enabled(stats_enabled)
+{
+	if (m_enabled)
+		m_start = clock::now();
+}
+
+callstats::Connection::~Connection()
+{
+	if (!m_enabled || m_function.empty())
+		return;
+
+	clock::time_point end = clock::now();
+	Sample sample;
+	sample.wall = end - m_start;
+	sample.wait = m_wait;
+	sample.convert = end - m_reply;
+	Record(m_collection, m_function, sample);
+}
+
+std::vector<ipc::value> callstats::Connection::call_synchronous_helper(const std::string &cname, const std::string &fname, std::vector<ipc::value> args)
+{
+	if (calltrace::IsRecording()) {
+		calltrace::Ticket ticket = calltrace::Begin();
+		std::vector<ipc::value> response = m_client->call_synchronous_helper(cname, fname, args);
+		calltrace::Record(ticket, clock::now(), cname, fname, args, response);
+		if (m_enabled)
+			Track(cname, fname, ticket.start);
+		return response;
+	}
+
+	if (!m_enabled)
+		return m_client->call_synchronous_helper(cname, fname, std::move(args));
+
+	clock::time_point start = clock::now();
+	std::vector<ipc::value> response = m_client->call_synchronous_helper(cname, fname, std::move(args));
+	Track(cname, fname, start);
+	return response;
+}
+
+void callstats::Connection::Track(const std::string &cname, const std::string &fname, clock::time_point start)
+{
+	clock::time_point reply = clock::now();
+
+	// Earlier calls of the same binding only count their wait, the binding
+	// time is given to the last call.
+	if (!m_function.empty()) {
+		Sample sample;
+		sample.wait = m_wait;
+		Record(m_collection, m_function, sample);
+	}
+
+	m_reply = reply;
+	m_wait = reply - start;
+	m_collection = cname;
+	m_function = fname;
+}
+
+Napi::Value callstats::SetEnabled(const Napi::CallbackInfo &info)
+{
+	stats_enabled = info[0].ToBoolean().Value();
+	return info.Env().Undefined();
+}
+
+Napi::Value callstats::GetStatistics(const Napi::CallbackInfo &info)
+{
+	std::vector<std::pair<std::string, CallStatistics>> calls;
+	{
+		std::unique_lock<std::mutex> ulock(stats_mtx);
+		calls.assign(stats_calls.begin(), stats_calls.end());
+	}
+
+	Napi::Array array = Napi::Array::New(info.Env(), calls.size());
+	for (size_t idx = 0; idx < calls.size(); idx++) {
+		const CallStatistics &stats = calls[idx].second;
+		Napi::Object call = Napi::Object::New(info.Env());
+		call.Set("name", Napi::String::New(info.Env(), calls[idx].first));
+		call.Set("calls", Napi::Number::New(info.Env(), double(stats.calls)));
+		call.Set("asyncCalls", Napi::Number::New(info.Env(), double(stats.asyncCalls)));
+		call.Set("wallUs", Napi::Number::New(info.Env(), double(stats.wallUs)));
+		call.Set("maxWallUs", Napi::Number::New(info.Env(), double(stats.maxWallUs)));
+		call.Set("queueUs", Napi::Number::New(info.Env(), double(stats.queueUs)));
+		call.Set("waitUs", Napi::Number::New(info.Env(), double(stats.waitUs)));
+		call.Set("maxWaitUs", Napi::Number::New(info.Env(), double(stats.maxWaitUs)));
+		call.Set("convertUs", Napi::Number::New(info.Env(), double(stats.convertUs)));
+		array.Set(uint32_t(idx), call);
+	}
+	return array;
+}
+
+Napi::Value callstats::Reset(const Napi::CallbackInfo &info)
+{
+	std::unique_lock<std::mutex> ulock(stats_mtx);
+	stats_calls.clear();
+	return info.Env().Undefined();
+}
@@ -0,0 +1,95 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <napi.h>
+#include "ipc-client.hpp"
+#include "call-trace.hpp"
+
+// Client side timing of server calls, aggregated by collection::function.
+// For every call it splits the time spent in the binding into:
+// - queue: waiting for an I/O thread (async calls only),
+// - wait: blocked on the reply, which is the socket transit plus the server
+//   queueing and handling (see the server "Profiler" for the handling part),
+// - convert: from the last reply until the result was handed back to JS.
+// It is disabled by default.
+namespace callstats {
+typedef std::chrono::steady_clock clock;
+
+bool IsEnabled();
+
+struct Sample {
+	std::chrono::nanoseconds wall{0};
+	std::chrono::nanoseconds queue{0};
+	std::chrono::nanoseconds wait{0};
+	std::chrono::nanoseconds convert{0};
+};
+
+void Record(const std::string &collection, const std::string &function, const Sample &sample);
+void RecordAsync(const std::string &collection, const std::string &function);
+
+// The connection handed to the bindings by GetConnection(). It forwards calls
+// to the client and times the synchronous ones, from its creation at the start
+// of the binding until the binding returns and destroys it. When a binding
+// makes several synchronous calls, the wall and convert times go to the last
+// one since its reply is the one being converted.
+class Connection {
+public:
+	explicit Connection(std::shared_ptr<ipc::client> client);
+	~Connection();
+
+	Connection(const Connection &) = delete;
+	Connection &operator=(const Connection &) = delete;
+
+	explicit operator bool() const { return !!m_client; }
+	operator std::shared_ptr<ipc::client>() const { return m_client; }
+	Connection *operator->() { return this; }
+
+	std::vector<ipc::value> call_synchronous_helper(const std::string &cname, const std::string &fname, std::vector<ipc::value> args);
+
+	template<typename... Args> decltype(auto) call(const std::string &cname, const std::string &fname, std::vector<ipc::value> args, Args &&...rest)
+	{
+		if (m_enabled)
+			RecordAsync(cname, fname);
+		if (calltrace::IsRecording())
+			calltrace::RecordAsync(cname, fname, args);
+		return m_client->call(cname, fname, std::move(args), std::forward<Args>(rest)...);
+	}
+
+	template<typename... Args> decltype(auto) set_freeze_callback(Args &&...args) { return m_client->set_freeze_callback(std::forward<Args>(args)...); }
+
+private:
+	void Track(const std::string &cname, const std::string &fname, clock::time_point start);
+
+	std::shared_ptr<ipc::client> m_client;
+	bool m_enabled;
+	clock::time_point m_start;
+	clock::time_point m_reply;
+	std::chrono::nanoseconds m_wait{0};
+	std::string m_collection;
+	std::string m_function;
+};
+
+Napi::Value SetEnabled(const Napi::CallbackInfo &info);
+Napi::Value GetStatistics(const Napi::CallbackInfo &info);
+Napi::Value Reset(const Napi::CallbackInfo &info);
+} // namespace callstats
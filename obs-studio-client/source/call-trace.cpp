@@ -0,0 +1,156 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "call-trace.hpp"
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include "osn-trace.hpp"
+
+static std::atomic<bool> trace_recording(false);
+static std::mutex trace_mtx;
+static std::ofstream trace_file;
+static std::chrono::steady_clock::time_point trace_start;
+// Reused between records, so recording does not allocate once it grew.
+static std::vector<char> trace_buffer;
+// Tickets handed out and the next one to be written. Records completed ahead
+// of an earlier ticket wait in trace_pending.
+static uint64_t trace_next = 0;
+static uint64_t trace_written = 0;
+static std::map<uint64_t, osn::trace::Record> trace_pending;
+
+static inline uint64_t Microseconds(std::chrono::steady_clock::duration duration)
+{
+	return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+static void WriteRecord(const osn::trace::Record &record)
+{
+	trace_buffer.clear();
+	osn::trace::write_record(trace_buffer, record);
+	trace_file.write(trace_buffer.data(), trace_buffer.size());
+}
+
+static void Write(const calltrace::Ticket &ticket, osn::trace::Record &&record)
+{
+	std::unique_lock<std::mutex> ulock(trace_mtx);
+	// Tickets of an earlier recording are dropped.
+	if (!trace_file.is_open() || ticket.sequence < trace_written)
+		return;
+
+	record.timestamp = ticket.start > trace_start ? Microseconds(ticket.start - trace_start) : 0;
+	if (ticket.sequence != trace_written) {
+		trace_pending.emplace(ticket.sequence, std::move(record));
+		return;
+	}
+
+	WriteRecord(record);
+	trace_written++;
+	for (auto iter = trace_pending.begin(); iter != trace_pending.end() && iter->first == trace_written; iter = trace_pending.erase(iter)) {
+		WriteRecord(iter->second);
+		trace_written++;
+	}
+}
+
+bool calltrace::Start(const std::string &path)
+{
+	std::unique_lock<std::mutex> ulock(trace_mtx);
+	if (trace_file.is_open())
+		trace_file.close();
+
+	trace_file.open(path, std::ios::binary | std::ios::trunc | std::ios::out);
+	if (!trace_file.is_open()) {
+		trace_recording = false;
+		return false;
+	}
+
+	trace_buffer.clear();
+	osn::trace::write_header(trace_buffer);
+	trace_file.write(trace_buffer.data(), trace_buffer.size());
+	trace_start = std::chrono::steady_clock::now();
+	trace_written = trace_next;
+	trace_pending.clear();
+	trace_recording = true;
+	return true;
+}
+
+void calltrace::Stop()
+{
+	std::unique_lock<std::mutex> ulock(trace_mtx);
+	trace_recording = false;
+	// Calls still waiting for an earlier reply are written as they are.
+	for (auto &pending : trace_pending)
+		WriteRecord(pending.second);
+	trace_pending.clear();
+	trace_written = trace_next;
+	if (trace_file.is_open())
+		trace_file.close();
+}
+
+bool calltrace::IsRecording()
+{
+	return trace_recording;
+}
+
+calltrace::Ticket calltrace::Begin()
+{
+	std::unique_lock<std::mutex> ulock(trace_mtx);
+	return Ticket{trace_next++, std::chrono::steady_clock::now()};
+}
+
+void calltrace::Record(const Ticket &ticket, std::chrono::steady_clock::time_point end, const std::string &collection, const std::string &function,
+		       const std::vector<ipc::value> &args, const std::vector<ipc::value> &reply)
+{
+	osn::trace::Record record;
+	record.duration = Microseconds(end - ticket.start);
+	record.collection = collection;
+	record.function = function;
+	record.args = args;
+	record.reply = reply;
+	Write(ticket, std::move(record));
+}
+
+void calltrace::RecordAsync(const std::string &collection, const std::string &function, const std::vector<ipc::value> &args)
+{
+	if (!trace_recording)
+		return;
+
+	osn::trace::Record record;
+	record.flags = osn::trace::RecordAsync;
+	record.collection = collection;
+	record.function = function;
+	record.args = args;
+	Write(Begin(), std::move(record));
+}
+
+Napi::Value calltrace::JSStart(const Napi::CallbackInfo &info)
+{
+	if (info.Length() != 1 || !info[0].IsString()) {
+		Napi::TypeError::New(info.Env(), "Invalid arguments, usage: StartCallTrace(<string> path).").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	return Napi::Boolean::New(info.Env(), Start(info[0].ToString().Utf8Value()));
+}
+
+Napi::Value calltrace::JSStop(const Napi::CallbackInfo &info)
+{
+	Stop();
+	return info.Env().Undefined();
+}
@@ -0,0 +1,52 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+#include <napi.h>
+#include "ipc-client.hpp"
+
+// Records the calls made on the server connection to a trace file (see
+// osn-trace.hpp), to be replayed against a fresh server by ipc-replay. It is
+// started from JS, or on connect when OSN_IPC_TRACE names the file to write.
+// Only calls going through the connection of GetConnection(info) and
+// async::Call are recorded.
+namespace calltrace {
+bool Start(const std::string &path);
+void Stop();
+bool IsRecording();
+
+// Position of a call in the trace, taken when the call is made. Records are
+// written in that order once the reply of every earlier call was recorded, so
+// the trace stays ordered by timestamp while replies complete out of order.
+// Every ticket must be passed to Record.
+struct Ticket {
+	uint64_t sequence;
+	std::chrono::steady_clock::time_point start;
+};
+Ticket Begin();
+
+void Record(const Ticket &ticket, std::chrono::steady_clock::time_point end, const std::string &collection, const std::string &function,
+	    const std::vector<ipc::value> &args, const std::vector<ipc::value> &reply);
+void RecordAsync(const std::string &collection, const std::string &function, const std::vector<ipc::value> &args);
+
+Napi::Value JSStart(const Napi::CallbackInfo &info);
+Napi::Value JSStop(const Napi::CallbackInfo &info);
+} // namespace calltrace
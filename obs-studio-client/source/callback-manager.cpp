@@ -18,9 +18,15 @@
 
 #include "callback-manager.hpp"
 #include "controller.hpp"
+#include "event-channel.hpp"
 #include "osn-error.hpp"
+#include "osn-volmeter-ring.hpp"
 #include "utility-v8.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
 #include <node.h>
 #include <sstream>
 #include <string>
@@ -30,14 +36,214 @@
 
 bool globalCallback::isWorkerRunning = false;
 bool globalCallback::worker_stop = true;
-uint32_t globalCallback::sleepIntervalMS = 50;
-std::thread *globalCallback::worker_thread = nullptr;
 Napi::ThreadSafeFunction globalCallback::js_source_callback;
 Napi::ThreadSafeFunction globalCallback::js_volmeter_callback;
 bool globalCallback::m_all_workers_stop = false;
 std::mutex globalCallback::mtx_volmeters;
 std::unordered_set<uint64_t> globalCallback::volmeters;
 
+static const uint32_t VOLMETER_RING_INTERVAL_MS = 16;
+// The ring is read less and less often while it stays empty, e.g. when no
+// meter is active, up to this interval.
+static const uint32_t VOLMETER_RING_IDLE_INTERVAL_MS = 128;
+
+static osn::VolmeterRing volmeter_ring;
+static std::thread *volmeter_ring_thread = nullptr;
+static std::atomic<bool> volmeter_ring_stop(true);
+// Wakes the worker up when it is stopped.
+static std::mutex volmeter_ring_mtx;
+static std::condition_variable volmeter_ring_cv;
+// Set while the frames handed to JS are in use, the ring is not read meanwhile.
+static std::atomic<bool> volmeter_ring_busy(false);
+static Napi::ThreadSafeFunction js_volmeter_buffer_callback;
+
+static void sources_callback(Napi::Env env, Napi::Function jsCallback, SourceSizeInfoData *data)
+{
+	try {
+		Napi::Array result = Napi::Array::New(env, data->items.size());
+
+		for (size_t i = 0; i < data->items.size(); i++) {
+			Napi::Object obj = Napi::Object::New(env);
+			obj.Set("name", Napi::String::New(env, data->items[i]->name));
+			obj.Set("width", Napi::Number::New(env, data->items[i]->width));
+			obj.Set("height", Napi::Number::New(env, data->items[i]->height));
+			obj.Set("flags", Napi::Number::New(env, data->items[i]->flags));
+			result.Set(i, obj);
+		}
+		jsCallback.Call({result});
+	} catch (...) {
+	}
+	delete data;
+}
+
+static void volmeter_callback(Napi::Env env, Napi::Function jsCallback, VolmeterDataArray *dataArray)
+{
+	try {
+		Napi::Array result = Napi::Array::New(env, dataArray->items.size());
+
+		for (size_t i = 0; i < dataArray->items.size(); i++) {
+			Napi::Object obj = Napi::Object::New(env);
+			VolmeterData *item = dataArray->items[i].get();
+
+			Napi::Array magnitude = Napi::Array::New(env);
+			Napi::Array peak = Napi::Array::New(env);
+			Napi::Array input_peak = Napi::Array::New(env);
+
+			for (size_t j = 0; j < item->magnitude.size(); j++) {
+				magnitude.Set(j, Napi::Number::New(env, item->magnitude[j]));
+			}
+			for (size_t j = 0; j < item->peak.size(); j++) {
+				peak.Set(j, Napi::Number::New(env, item->peak[j]));
+			}
+			for (size_t j = 0; j < item->input_peak.size(); j++) {
+				input_peak.Set(j, Napi::Number::New(env, item->input_peak[j]));
+			}
+
+			obj.Set("sourceName", Napi::String::New(env, item->source_name));
+			obj.Set("magnitude", magnitude);
+			obj.Set("peak", peak);
+			obj.Set("inputPeak", input_peak);
+
+			result.Set(i, obj);
+		}
+
+		jsCallback.Call({result});
+	} catch (...) {
+	}
+
+	delete dataArray;
+}
+
+static void on_source_sizes(const std::vector<const EventChannel::Event *> &events)
+{
+	if (globalCallback::m_all_workers_stop)
+		return;
+
+	SourceSizeInfoData *data = new SourceSizeInfoData{{}};
+	for (auto event : events) {
+		if (event->values.size() < 5)
+			continue;
+
+		SourceSizeInfo *item = new SourceSizeInfo;
+		item->name = event->values[1].value_str;
+		item->width = event->values[2].value_union.ui32;
+		item->height = event->values[3].value_union.ui32;
+		item->flags = event->values[4].value_union.ui32;
+		data->items.emplace_back(item);
+	}
+
+	if (data->items.empty()) {
+		delete data;
+		return;
+	}
+
+	napi_status status = globalCallback::js_source_callback.NonBlockingCall(data, sources_callback);
+	if (status != napi_ok)
+		delete data;
+}
+
+static void on_volmeters(const std::vector<const EventChannel::Event *> &events)
+{
+	if (globalCallback::m_all_workers_stop)
+		return;
+
+	auto volmeterDataArray = new VolmeterDataArray;
+	{
+		std::unique_lock<std::mutex> ulock(globalCallback::mtx_volmeters);
+		for (auto event : events) {
+			const std::vector<ipc::value> &values = event->values;
+			if (values.size() < 3 || globalCallback::volmeters.count(values[0].value_union.ui64) == 0)
+				continue;
+
+			size_t channels = values[2].value_union.i32;
+			if (values.size() < 3 + channels * 3)
+				continue;
+
+			VolmeterData *item = new VolmeterData{{}, {}, {}};
+			item->source_name = values[1].value_str;
+			item->magnitude.resize(channels);
+			item->peak.resize(channels);
+			item->input_peak.resize(channels);
+			for (size_t ch = 0; ch < channels; ch++) {
+				item->magnitude[ch] = values[3 + ch * 3 + 0].value_union.fp32;
+				item->peak[ch] = values[3 + ch * 3 + 1].value_union.fp32;
+				item->input_peak[ch] = values[3 + ch * 3 + 2].value_union.fp32;
+			}
+			volmeterDataArray->items.emplace_back(item);
+		}
+	}
+
+	if (volmeterDataArray->items.empty()) {
+		delete volmeterDataArray;
+		return;
+	}
+
+	napi_status status = globalCallback::js_volmeter_callback.NonBlockingCall(volmeterDataArray, volmeter_callback);
+	if (status != napi_ok)
+		delete volmeterDataArray;
+}
+
+static void volmeter_buffer_callback(Napi::Env env, Napi::Function jsCallback)
+{
+	size_t count = 0;
+	const osn::VolmeterFrame *frames = volmeter_ring.Peek(count);
+	if (count > 0 && !globalCallback::m_all_workers_stop) {
+		try {
+			// The frames are handed to JS in place. Runtimes that do not allow
+			// external buffers, such as Electron, get a single copy instead.
+			size_t size = count * sizeof(osn::VolmeterFrame);
+			bool external = true;
+			napi_value value;
+			if (napi_create_external_arraybuffer(env, const_cast<osn::VolmeterFrame *>(frames), size, nullptr, nullptr, &value) != napi_ok) {
+				external = false;
+				Napi::ArrayBuffer copy = Napi::ArrayBuffer::New(env, size);
+				memcpy(copy.Data(), frames, size);
+				value = copy;
+			}
+
+			Napi::ArrayBuffer buffer(env, value);
+			size_t words = count * osn::VOLMETER_FRAME_WORDS;
+			jsCallback.Call({Napi::Float32Array::New(env, words, buffer, 0), Napi::Uint32Array::New(env, words, buffer, 0)});
+
+			// The frames are reused by the server once consumed, views kept by
+			// the callback must not see them anymore.
+			if (external)
+				buffer.Detach();
+		} catch (...) {
+		}
+	}
+
+	volmeter_ring.Consume(count);
+	volmeter_ring_busy = false;
+}
+
+static void volmeter_ring_worker()
+{
+	// Reading the ring is a plain memory access, no IPC is involved here.
+	// Drop what was left over since the last callback was removed, unless a
+	// previous callback still has frames in use.
+	size_t count = 0;
+	while (!volmeter_ring_busy && volmeter_ring.Peek(count) && count > 0)
+		volmeter_ring.Consume(count);
+
+	uint32_t interval = VOLMETER_RING_INTERVAL_MS;
+	std::unique_lock<std::mutex> ulock(volmeter_ring_mtx);
+	while (!volmeter_ring_stop) {
+		if (!volmeter_ring_busy) {
+			volmeter_ring.Peek(count);
+			if (count > 0 && !globalCallback::m_all_workers_stop) {
+				volmeter_ring_busy = true;
+				napi_status status = js_volmeter_buffer_callback.NonBlockingCall(volmeter_buffer_callback);
+				if (status != napi_ok)
+					volmeter_ring_busy = false;
+			}
+			interval = count > 0 ? VOLMETER_RING_INTERVAL_MS : std::min(interval * 2, VOLMETER_RING_IDLE_INTERVAL_MS);
+		}
+
+		volmeter_ring_cv.wait_for(ulock, std::chrono::milliseconds(interval), [] { return volmeter_ring_stop.load(); });
+	}
+}
+
 void globalCallback::Init(Napi::Env env, Napi::Object exports)
 {
 	exports.Set(Napi::String::New(env, "RegisterSourceCallback"), Napi::Function::New(env, globalCallback::RegisterSourceCallback));
@@ -45,6 +251,9 @@ void globalCallback::Init(Napi::Env env, Napi::Object exports)
 
 	exports.Set(Napi::String::New(env, "RegisterVolmeterCallback"), Napi::Function::New(env, globalCallback::RegisterVolmeterCallback));
 	exports.Set(Napi::String::New(env, "RemoveVolmeterCallback"), Napi::Function::New(env, globalCallback::RemoveVolmeterCallback));
+
+	exports.Set(Napi::String::New(env, "RegisterVolmeterBufferCallback"), Napi::Function::New(env, globalCallback::RegisterVolmeterBufferCallback));
+	exports.Set(Napi::String::New(env, "RemoveVolmeterBufferCallback"), Napi::Function::New(env, globalCallback::RemoveVolmeterBufferCallback));
 }
 
 Napi::Value globalCallback::RegisterSourceCallback(const Napi::CallbackInfo &info)
@@ -52,10 +261,6 @@ Napi::Value globalCallback::RegisterSourceCallback(const Napi::CallbackInfo &inf
 	Napi::Function async_callback = info[0].As<Napi::Function>();
 
 	start_worker(info.Env(), async_callback);
-	isWorkerRunning = true;
-	worker_stop = false;
-
-	worker_thread = new std::thread(&globalCallback::worker);
 
 	return Napi::Boolean::New(info.Env(), true);
 }
@@ -72,193 +277,106 @@ Napi::Value globalCallback::RegisterVolmeterCallback(const Napi::CallbackInfo &i
 {
 	Napi::Function async_callback = info[0].As<Napi::Function>();
 	js_volmeter_callback = Napi::ThreadSafeFunction::New(info.Env(), async_callback, "VolmeterCallback", 0, 1, [](Napi::Env) {});
+	EventChannel::GetInstance().Subscribe(osn::EventType::Volmeter, &js_volmeter_callback, on_volmeters);
 
 	return Napi::Boolean::New(info.Env(), true);
 }
 
 Napi::Value globalCallback::RemoveVolmeterCallback(const Napi::CallbackInfo &info)
 {
+	EventChannel::GetInstance().Unsubscribe(osn::EventType::Volmeter, &js_volmeter_callback);
 	js_volmeter_callback.Release();
 	return info.Env().Undefined();
 }
 
-void globalCallback::start_worker(napi_env env, Napi::Function async_callback)
-{
-	if (!worker_stop)
-		return;
-
-	js_source_callback = Napi::ThreadSafeFunction::New(env, async_callback, "SourceCallback", 0, 1, [](Napi::Env) {});
-}
-
-void globalCallback::stop_worker(void)
+Napi::Value globalCallback::RegisterVolmeterBufferCallback(const Napi::CallbackInfo &info)
 {
-	if (worker_stop != false)
-		return;
-
-	worker_stop = true;
-	if (worker_thread->joinable()) {
-		worker_thread->join();
+	if (info.Length() < 1 || !info[0].IsFunction()) {
+		Napi::TypeError::New(info.Env(), "Invalid arguments, usage: RegisterVolmeterBufferCallback(<function> callback).").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
 	}
-	js_source_callback.Release();
-}
-
-void globalCallback::worker()
-{
-	auto sources_callback = [](Napi::Env env, Napi::Function jsCallback, SourceSizeInfoData *data) {
-		try {
-			Napi::Array result = Napi::Array::New(env, data->items.size());
-
-			for (size_t i = 0; i < data->items.size(); i++) {
-				Napi::Object obj = Napi::Object::New(env);
-				obj.Set("name", Napi::String::New(env, data->items[i]->name));
-				obj.Set("width", Napi::Number::New(env, data->items[i]->width));
-				obj.Set("height", Napi::Number::New(env, data->items[i]->height));
-				obj.Set("flags", Napi::Number::New(env, data->items[i]->flags));
-				result.Set(i, obj);
-			}
-			jsCallback.Call({result});
-		} catch (...) {
-		}
-		delete data;
-	};
 
-	auto volmeter_callback = [](Napi::Env env, Napi::Function jsCallback, VolmeterDataArray *dataArray) {
-		try {
-			Napi::Array result = Napi::Array::New(env, dataArray->items.size());
-
-			for (size_t i = 0; i < dataArray->items.size(); i++) {
-				Napi::Object obj = Napi::Object::New(env);
-				VolmeterData *item = dataArray->items[i].get();
-
-				Napi::Array magnitude = Napi::Array::New(env);
-				Napi::Array peak = Napi::Array::New(env);
-				Napi::Array input_peak = Napi::Array::New(env);
-
-				for (size_t j = 0; j < item->magnitude.size(); j++) {
-					magnitude.Set(j, Napi::Number::New(env, item->magnitude[j]));
-				}
-				for (size_t j = 0; j < item->peak.size(); j++) {
-					peak.Set(j, Napi::Number::New(env, item->peak[j]));
-				}
-				for (size_t j = 0; j < item->input_peak.size(); j++) {
-					input_peak.Set(j, Napi::Number::New(env, item->input_peak[j]));
-				}
-
-				obj.Set("sourceName", Napi::String::New(env, item->source_name));
-				obj.Set("magnitude", magnitude);
-				obj.Set("peak", peak);
-				obj.Set("inputPeak", input_peak);
-
-				result.Set(i, obj);
-			}
-
-			jsCallback.Call({result});
-		} catch (...) {
-		}
-
-		delete dataArray;
-	};
+	if (!volmeter_ring_stop)
+		return Napi::Boolean::New(info.Env(), true);
 
-	size_t totalSleepMS = 0;
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
 
-	while (!worker_stop && !m_all_workers_stop) {
-		auto tp_start = std::chrono::high_resolution_clock::now();
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Volmeter", "OpenRing", {});
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
 
-		auto conn = Controller::GetInstance().GetConnection();
-		if (!conn)
-			return;
-
-		mtx_volmeters.lock();
-		std::vector<char> volmeters_ids;
-		{
-			uint32_t index = 0;
-			volmeters_ids.resize(sizeof(uint64_t) * volmeters.size());
-			for (auto vol : volmeters) {
-				*reinterpret_cast<uint64_t *>(volmeters_ids.data() + index) = vol;
-				index += sizeof(uint64_t);
-			}
-		}
-
-		{
-			std::vector<ipc::value> response = conn->call_synchronous_helper(
-				"CallbackManager", "GlobalQuery", {ipc::value((uint64_t)volmeters_ids.size()), ipc::value(volmeters_ids)});
-			if (!response.size() || (response.size() == 1)) {
-				goto do_sleep;
-			}
-
-			uint32_t index = 1;
+	if (!volmeter_ring.IsOpen() && !volmeter_ring.Open(response[1].value_str)) {
+		conn->call("Volmeter", "CloseRing", {});
+		Napi::Error::New(info.Env(), "Failed to open the volmeter ring.").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
 
-			SourceSizeInfoData *data = new SourceSizeInfoData{{}};
-			for (int i = 2; i < (response[1].value_union.ui32 * 4) + 2; i++) {
-				SourceSizeInfo *item = new SourceSizeInfo;
+	js_volmeter_buffer_callback =
+		Napi::ThreadSafeFunction::New(info.Env(), info[0].As<Napi::Function>(), "VolmeterBufferCallback", 0, 1, [](Napi::Env) {});
+	volmeter_ring_stop = false;
+	volmeter_ring_thread = new std::thread(volmeter_ring_worker);
 
-				item->name = response[i++].value_str;
-				item->width = response[i++].value_union.ui32;
-				item->height = response[i++].value_union.ui32;
-				item->flags = response[i].value_union.ui32;
-				data->items.emplace_back(item);
-				index = i;
-			}
+	return Napi::Boolean::New(info.Env(), true);
+}
 
-			if (data->items.size() > 0) {
-				napi_status status = js_source_callback.NonBlockingCall(data, sources_callback);
-				if (status != napi_ok) {
-					delete data;
-				}
-			}
+Napi::Value globalCallback::RemoveVolmeterBufferCallback(const Napi::CallbackInfo &info)
+{
+	if (volmeter_ring_stop)
+		return info.Env().Undefined();
 
-			index++;
+	{
+		std::unique_lock<std::mutex> ulock(volmeter_ring_mtx);
+		volmeter_ring_stop = true;
+	}
+	volmeter_ring_cv.notify_all();
+	if (volmeter_ring_thread->joinable())
+		volmeter_ring_thread->join();
+	delete volmeter_ring_thread;
+	volmeter_ring_thread = nullptr;
+	js_volmeter_buffer_callback.Release();
 
-			auto volmeterDataArray = new VolmeterDataArray;
-			for (auto vol : volmeters) {
-				VolmeterData *item = new VolmeterData{{}, {}, {}};
+	auto conn = GetConnection(info);
+	if (conn)
+		conn->call("Volmeter", "CloseRing", {});
 
-				item->source_name = response[index++].value_str;
+	return info.Env().Undefined();
+}
 
-				size_t channels = response[index++].value_union.i32;
-				bool isMuted = response[index++].value_union.i32;
+void globalCallback::start_worker(napi_env env, Napi::Function async_callback)
+{
+	if (!worker_stop)
+		return;
 
-				if (!isMuted) {
-					item->magnitude.resize(channels);
-					item->peak.resize(channels);
-					item->input_peak.resize(channels);
-					for (size_t ch = 0; ch < channels; ch++) {
-						item->magnitude[ch] = response[index + ch * 3 + 0].value_union.fp32;
-						item->peak[ch] = response[index + ch * 3 + 1].value_union.fp32;
-						item->input_peak[ch] = response[index + ch * 3 + 2].value_union.fp32;
-					}
+	js_source_callback = Napi::ThreadSafeFunction::New(env, async_callback, "SourceCallback", 0, 1, [](Napi::Env) {});
+	isWorkerRunning = true;
+	worker_stop = false;
 
-					index += (3 * channels);
+	EventChannel::GetInstance().Subscribe(osn::EventType::SourceSize, &js_source_callback, on_source_sizes);
+}
 
-					volmeterDataArray->items.emplace_back(item);
-				}
-			}
+void globalCallback::stop_worker(void)
+{
+	if (worker_stop != false)
+		return;
 
-			if (js_volmeter_callback) {
-				napi_status status = js_volmeter_callback.NonBlockingCall(volmeterDataArray, volmeter_callback);
-				if (status != napi_ok) {
-					delete volmeterDataArray;
-				}
-			}
-		}
+	worker_stop = true;
+	isWorkerRunning = false;
 
-	do_sleep:
-		mtx_volmeters.unlock();
-		auto tp_end = std::chrono::high_resolution_clock::now();
-		auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
-		totalSleepMS = sleepIntervalMS - dur.count();
-		if (totalSleepMS > 0)
-			std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
-	}
-	return;
+	// Once unsubscribed, the channel thread no longer uses the callback.
+	EventChannel::GetInstance().Unsubscribe(osn::EventType::SourceSize, &js_source_callback);
+	js_source_callback.Release();
 }
 
 void globalCallback::add_volmeter(uint64_t id)
 {
+	std::unique_lock<std::mutex> ulock(mtx_volmeters);
 	volmeters.insert(id);
 }
 
 void globalCallback::remove_volmeter(uint64_t id)
 {
+	std::unique_lock<std::mutex> ulock(mtx_volmeters);
 	volmeters.erase(id);
 }
\ No newline at end of file
@@ -36,8 +36,6 @@ struct SourceSizeInfoData {
 namespace globalCallback {
 extern bool isWorkerRunning;
 extern bool worker_stop;
-extern uint32_t sleepIntervalMS;
-extern std::thread *worker_thread;
 extern Napi::ThreadSafeFunction js_source_callback;
 extern Napi::ThreadSafeFunction js_volmeter_callback;
 extern bool m_all_workers_stop;
@@ -45,7 +43,6 @@ extern bool m_all_workers_stop;
 extern std::mutex mtx_volmeters;
 extern std::unordered_set<uint64_t> volmeters;
 
-void worker(void);
 void start_worker(napi_env env, Napi::Function async_callback);
 void stop_worker(void);
 
@@ -59,4 +56,10 @@ Napi::Value RemoveSourceCallback(const Napi::CallbackInfo &info);
 
 Napi::Value RegisterVolmeterCallback(const Napi::CallbackInfo &info);
 Napi::Value RemoveVolmeterCallback(const Napi::CallbackInfo &info);
+
+// Volmeter frames read from the shared memory ring, handed to JS as a
+// Float32Array and a Uint32Array over the same osn::VOLMETER_FRAME_WORDS words
+// per frame. The views are only valid during the callback.
+Napi::Value RegisterVolmeterBufferCallback(const Napi::CallbackInfo &info);
+Napi::Value RemoveVolmeterBufferCallback(const Napi::CallbackInfo &info);
 }
\ No newline at end of file
@@ -25,6 +25,10 @@
 #include <string>
 #include "shared.hpp"
 #include "utility.hpp"
+#include "async-call.hpp"
+#include "call-trace.hpp"
+#include "call-batch.hpp"
+#include "event-channel.hpp"
 
 static std::string serverBinaryPath = "";
 static std::string serverWorkingPath = "";
@@ -369,11 +373,26 @@ std::shared_ptr<ipc::client> Controller::connect(const std::string &uri)
 	}
 
 	m_connection = cl;
+#ifdef WIN32
+	m_path = uri;
+#else
+	m_path = "/tmp/" + uri;
+#endif
+
+	// Record the whole session for ipc-replay
+	const char *tracePath = getenv("OSN_IPC_TRACE");
+	if (tracePath && *tracePath)
+		calltrace::Start(tracePath);
+
 	return m_connection;
 }
 
 void Controller::disconnect()
 {
+	EventChannel::GetInstance().Stop();
+	async::Stop();
+	calltrace::Stop();
+
 	if (m_isServer) {
 		m_connection->call_synchronous_helper("System", "Shutdown", {});
 		m_isServer = false;
@@ -391,6 +410,18 @@ std::shared_ptr<ipc::client> Controller::GetConnection()
 	return m_connection;
 }
 
+std::shared_ptr<ipc::client> Controller::CreateConnection()
+{
+	if (!m_connection || m_path.empty())
+		return nullptr;
+
+	try {
+		return ipc::client::create(m_path);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
 Napi::Value js_setServerPath(const Napi::CallbackInfo &info)
 {
 	if (info.Length() == 0) {
@@ -488,5 +519,6 @@ void Controller::Init(Napi::Env env, Napi::Object exports)
 	obj.Set(Napi::String::New(env, "connect"), Napi::Function::New(env, js_connect));
 	obj.Set(Napi::String::New(env, "host"), Napi::Function::New(env, js_host));
 	obj.Set(Napi::String::New(env, "disconnect"), Napi::Function::New(env, js_disconnect));
+	obj.Set(Napi::String::New(env, "batch"), Napi::Function::New(env, CallBatch::JSExecute));
 	exports.Set("IPC", obj);
 }
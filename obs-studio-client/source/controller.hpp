@@ -53,8 +53,13 @@ public:
 
 	std::shared_ptr<ipc::client> GetConnection();
 
+	// Opens an additional connection to the server the client is connected
+	// to, for calls that block such as EventChannel::Wait.
+	std::shared_ptr<ipc::client> CreateConnection();
+
 private:
 	bool m_isServer = false;
 	std::shared_ptr<ipc::client> m_connection;
+	std::string m_path;
 	ipc::ProcessInfo procId;
 };
@@ -0,0 +1,172 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "event-channel.hpp"
+#include <chrono>
+#include "controller.hpp"
+#include "osn-error.hpp"
+
+static const uint32_t WAIT_TIMEOUT_MS = 500;
+static const uint32_t FALLBACK_INTERVAL_MS = 33;
+
+uint32_t EventChannel::GetMask()
+{
+	uint32_t mask = 0;
+	for (auto &subscriber : subscribers) {
+		if (!subscriber.second.empty())
+			mask |= osn::EventMask(subscriber.first);
+	}
+	return mask;
+}
+
+void EventChannel::Subscribe(osn::EventType type, const void *owner, Handler handler)
+{
+	std::unique_lock<std::mutex> wlock(workerMtx);
+	uint32_t mask = 0;
+	{
+		std::unique_lock<std::mutex> ulock(subscribersMtx);
+		subscribers[type][owner] = handler;
+		mask = GetMask();
+	}
+
+	auto conn = Controller::GetInstance().GetConnection();
+	if (!conn)
+		return;
+
+	// Open synchronously so that events raised by the next call, such as
+	// starting an output, are already routed to the channel.
+	conn->call_synchronous_helper("EventChannel", "Open", {ipc::value(mask)});
+
+	if (!workerThread) {
+		workerStop = false;
+		workerThread = new std::thread(&EventChannel::Worker, this);
+	}
+}
+
+void EventChannel::Unsubscribe(osn::EventType type, const void *owner)
+{
+	std::unique_lock<std::mutex> wlock(workerMtx);
+	uint32_t mask = 0;
+	{
+		std::unique_lock<std::mutex> ulock(subscribersMtx);
+		auto iter = subscribers.find(type);
+		if (iter == subscribers.end())
+			return;
+		iter->second.erase(owner);
+		mask = GetMask();
+	}
+
+	if (mask == 0) {
+		StopWorker();
+		return;
+	}
+
+	auto conn = Controller::GetInstance().GetConnection();
+	if (conn)
+		conn->call_synchronous_helper("EventChannel", "Open", {ipc::value(mask)});
+}
+
+void EventChannel::Stop()
+{
+	std::unique_lock<std::mutex> wlock(workerMtx);
+	{
+		std::unique_lock<std::mutex> ulock(subscribersMtx);
+		subscribers.clear();
+	}
+	StopWorker();
+}
+
+void EventChannel::StopWorker()
+{
+	if (!workerThread)
+		return;
+
+	workerStop = true;
+
+	// Closing the channel also wakes up the pending Wait call.
+	auto conn = Controller::GetInstance().GetConnection();
+	if (conn)
+		conn->call_synchronous_helper("EventChannel", "Close", {});
+
+	if (workerThread->joinable())
+		workerThread->join();
+	delete workerThread;
+	workerThread = nullptr;
+}
+
+void EventChannel::Worker()
+{
+	// Wait blocks on the server, give it a connection of its own so that it
+	// does not hold back regular calls. If that fails, fall back to the
+	// shared connection and do not block.
+	uint32_t timeout = WAIT_TIMEOUT_MS;
+	std::shared_ptr<ipc::client> conn = Controller::GetInstance().CreateConnection();
+	if (!conn) {
+		conn = Controller::GetInstance().GetConnection();
+		timeout = 0;
+	}
+
+	std::vector<Event> events;
+	while (!workerStop && conn) {
+		std::vector<ipc::value> response = conn->call_synchronous_helper("EventChannel", "Wait", {ipc::value(timeout)});
+
+		events.clear();
+		if (response.size() >= 2 && response[0].type != ipc::type::Null && (ErrorCode)response[0].value_union.ui64 == ErrorCode::Ok) {
+			uint32_t count = response[1].value_union.ui32;
+			size_t index = 2;
+			for (uint32_t i = 0; i < count && index + 2 <= response.size(); i++) {
+				Event event;
+				event.type = (osn::EventType)response[index++].value_union.ui32;
+				size_t size = response[index++].value_union.ui32;
+				if (index + size > response.size())
+					break;
+
+				event.values.assign(response.begin() + index, response.begin() + index + size);
+				index += size;
+				events.push_back(std::move(event));
+			}
+		} else {
+			// Connection issue, avoid spinning until the channel is stopped.
+			std::this_thread::sleep_for(std::chrono::milliseconds(FALLBACK_INTERVAL_MS));
+			continue;
+		}
+
+		if (!events.empty())
+			Dispatch(events);
+
+		if (timeout == 0)
+			std::this_thread::sleep_for(std::chrono::milliseconds(FALLBACK_INTERVAL_MS));
+	}
+}
+
+void EventChannel::Dispatch(const std::vector<Event> &events)
+{
+	std::map<osn::EventType, std::vector<const Event *>> byType;
+	for (auto &event : events)
+		byType[event.type].push_back(&event);
+
+	std::unique_lock<std::mutex> ulock(subscribersMtx);
+	for (auto &group : byType) {
+		auto iter = subscribers.find(group.first);
+		if (iter == subscribers.end())
+			continue;
+
+		for (auto &subscriber : iter->second)
+			subscriber.second(group.second);
+	}
+}
@@ -0,0 +1,76 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ipc-client.hpp"
+#include "osn-events.hpp"
+
+// Receives the events pushed by the server on a dedicated thread and
+// connection, and hands them to the subscribers of each event type. The
+// thread keeps a single Wait call pending on the server, so there is no
+// polling interval and nothing is sent while nothing happens.
+class EventChannel {
+public:
+	struct Event {
+		osn::EventType type;
+		std::vector<ipc::value> values;
+	};
+
+	// Handlers are called on the channel thread with all the events of their
+	// type received in one go. They must not block on the JS thread, use
+	// Napi::ThreadSafeFunction::NonBlockingCall to reach it.
+	typedef std::function<void(const std::vector<const Event *> &events)> Handler;
+
+	static EventChannel &GetInstance()
+	{
+		static EventChannel _inst;
+		return _inst;
+	}
+
+private:
+	EventChannel(){};
+	~EventChannel(){};
+
+public:
+	EventChannel(EventChannel const &) = delete;
+	void operator=(EventChannel const &) = delete;
+
+public:
+	void Subscribe(osn::EventType type, const void *owner, Handler handler);
+	void Unsubscribe(osn::EventType type, const void *owner);
+	void Stop();
+
+private:
+	uint32_t GetMask();
+	void StopWorker();
+	void Worker();
+	void Dispatch(const std::vector<Event> &events);
+
+	std::mutex subscribersMtx;
+	std::map<osn::EventType, std::map<const void *, Handler>> subscribers;
+
+	std::mutex workerMtx;
+	std::thread *workerThread = nullptr;
+	std::atomic<bool> workerStop{false};
+};
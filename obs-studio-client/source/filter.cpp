@@ -38,6 +38,7 @@ Napi::Object osn::Filter::Init(Napi::Env env, Napi::Object exports)
 
 						  InstanceAccessor("configurable", &osn::Filter::CallIsConfigurable, nullptr),
 						  InstanceAccessor("properties", &osn::Filter::CallGetProperties, nullptr),
+						  InstanceMethod("getPropertiesAsync", &osn::Filter::CallGetPropertiesAsync),
 						  InstanceAccessor("settings", &osn::Filter::CallGetSettings, nullptr),
 						  InstanceAccessor("slowUncachedSettings", &osn::Filter::CallGetSlowUncachedSettings, nullptr),
 						  InstanceAccessor("type", &osn::Filter::CallGetType, nullptr),
@@ -152,11 +153,16 @@ Napi::Value osn::Filter::CallGetProperties(const Napi::CallbackInfo &info)
 	return osn::ISource::GetProperties(info, this->sourceId);
 }
 
+Napi::Value osn::Filter::CallGetPropertiesAsync(const Napi::CallbackInfo &info)
+{
+	return osn::ISource::GetPropertiesAsync(info, this->sourceId);
+}
+
 Napi::Value osn::Filter::CallGetSettings(const Napi::CallbackInfo &info)
 {
 	Napi::Value ret = osn::ISource::GetSettings(info, this->sourceId);
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi && sdi->obs_sourceId.compare("vst_filter") == 0) {
 		sdi->settingsChanged = true;
 	}
@@ -252,7 +258,7 @@ Napi::Value osn::Filter::CallUpdate(const Napi::CallbackInfo &info)
 {
 	osn::ISource::Update(info, this->sourceId);
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi && sdi->obs_sourceId.compare("vst_filter") == 0) {
 		sdi->settingsChanged = true;
 	}
@@ -36,6 +36,7 @@ public:
 
 	Napi::Value CallIsConfigurable(const Napi::CallbackInfo &info);
 	Napi::Value CallGetProperties(const Napi::CallbackInfo &info);
+	Napi::Value CallGetPropertiesAsync(const Napi::CallbackInfo &info);
 	Napi::Value CallGetSettings(const Napi::CallbackInfo &info);
 	Napi::Value CallGetSlowUncachedSettings(const Napi::CallbackInfo &info);
 
@@ -22,6 +22,7 @@
 #include <string>
 #include <algorithm>
 #include <iterator>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "osn-error.hpp"
 #include "filter.hpp"
@@ -38,6 +39,7 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports)
 		DefineClass(env, "Input",
 			    {StaticMethod("types", &osn::Input::Types),
 			     StaticMethod("create", &osn::Input::Create),
+			     StaticMethod("createAsync", &osn::Input::CreateAsync),
 			     StaticMethod("createPrivate", &osn::Input::CreatePrivate),
 			     StaticMethod("fromName", &osn::Input::FromName),
 			     StaticMethod("getPublicSources", &osn::Input::GetPublicSources),
@@ -64,6 +66,7 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports)
 
 			     InstanceAccessor("configurable", &osn::Input::CallIsConfigurable, nullptr),
 			     InstanceAccessor("properties", &osn::Input::CallGetProperties, nullptr),
+			     InstanceMethod("getPropertiesAsync", &osn::Input::CallGetPropertiesAsync),
 			     InstanceAccessor("settings", &osn::Input::CallGetSettings, nullptr),
 			     InstanceAccessor("slowUncachedSettings", &osn::Input::CallGetSlowUncachedSettings, nullptr),
 			     InstanceAccessor("type", &osn::Input::CallGetType, nullptr),
@@ -132,7 +135,7 @@ Napi::Value osn::Input::Types(const Napi::CallbackInfo &info)
 	return utilv8::ToValue<std::string>(info, types);
 }
 
-Napi::Value osn::Input::Create(const Napi::CallbackInfo &info)
+static std::vector<ipc::value> CreateArguments(const Napi::CallbackInfo &info)
 {
 	std::string type = info[0].ToString().Utf8Value();
 	std::string name = info[1].ToString().Utf8Value();
@@ -156,10 +159,6 @@ Napi::Value osn::Input::Create(const Napi::CallbackInfo &info)
 		}
 	}
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
 	auto params = std::vector<ipc::value>{ipc::value(type), ipc::value(name)};
 	if (settings.Utf8Value().length() != 0) {
 		std::string value;
@@ -173,11 +172,13 @@ Napi::Value osn::Input::Create(const Napi::CallbackInfo &info)
 			params.push_back(ipc::value(value));
 		}
 	}
+	return params;
+}
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "Create", {std::move(params)});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
+static Napi::Value InputFromResponse(Napi::Env env, const std::string &type, const std::string &name, std::vector<ipc::value> &response)
+{
+	if (!ValidateResponse(env, response))
+		return env.Undefined();
 
 	SourceDataInfo *sdi = new SourceDataInfo;
 	sdi->name = name;
@@ -190,11 +191,36 @@ Napi::Value osn::Input::Create(const Napi::CallbackInfo &info)
 
 	CacheManager<SourceDataInfo *>::getInstance().Store(response[1].value_union.ui64, name, sdi);
 
-	auto instance = osn::Input::constructor.New({Napi::Number::New(info.Env(), response[1].value_union.ui64)});
+	auto instance = osn::Input::constructor.New({Napi::Number::New(env, response[1].value_union.ui64)});
 
 	return instance;
 }
 
+Napi::Value osn::Input::Create(const Napi::CallbackInfo &info)
+{
+	std::string type = info[0].ToString().Utf8Value();
+	std::string name = info[1].ToString().Utf8Value();
+	std::vector<ipc::value> params = CreateArguments(info);
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "Create", {std::move(params)});
+
+	return InputFromResponse(info.Env(), type, name, response);
+}
+
+Napi::Value osn::Input::CreateAsync(const Napi::CallbackInfo &info)
+{
+	std::string type = info[0].ToString().Utf8Value();
+	std::string name = info[1].ToString().Utf8Value();
+
+	return async::Call(info.Env(), "Input", "Create", CreateArguments(info), [type, name](Napi::Env env, std::vector<ipc::value> &response) {
+		return InputFromResponse(env, type, name, response);
+	});
+}
+
 Napi::Value osn::Input::CreatePrivate(const Napi::CallbackInfo &info)
 {
 	std::string type = info[0].ToString().Utf8Value();
@@ -245,7 +271,7 @@ Napi::Value osn::Input::FromName(const Napi::CallbackInfo &info)
 {
 	std::string name = info[0].ToString().Utf8Value();
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(name);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(name);
 
 	if (sdi) {
 		auto instance = osn::Input::constructor.New({Napi::Number::New(info.Env(), sdi->id)});
@@ -432,7 +458,7 @@ void osn::Input::SetSyncOffset(const Napi::CallbackInfo &info, const Napi::Value
 
 Napi::Value osn::Input::GetAudioMixers(const Napi::CallbackInfo &info)
 {
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi && !sdi->audioMixersChanged && sdi->audioMixers != UINT32_MAX)
 		return Napi::Number::New(info.Env(), sdi->audioMixers);
 
@@ -463,7 +489,7 @@ void osn::Input::SetAudioMixers(const Napi::CallbackInfo &info, const Napi::Valu
 
 	conn->call("Input", "SetAudioMixers", {ipc::value((uint64_t)this->sourceId), ipc::value(audiomixers)});
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi) {
 		sdi->audioMixersChanged = true;
 	}
@@ -546,13 +572,13 @@ void osn::Input::SetDeinterlaceMode(const Napi::CallbackInfo &info, const Napi::
 
 Napi::Value osn::Input::Filters(const Napi::CallbackInfo &info)
 {
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 
 	if (sdi && !sdi->filtersOrderChanged) {
-		std::vector<uint64_t> *filters = sdi->filters;
-		Napi::Array array = Napi::Array::New(info.Env(), int(filters->size()));
-		for (uint32_t i = 0; i < filters->size(); i++) {
-			auto instance = osn::Filter::constructor.New({Napi::Number::New(info.Env(), filters->at(i))});
+		const std::vector<uint64_t> &filters = sdi->filters;
+		Napi::Array array = Napi::Array::New(info.Env(), int(filters.size()));
+		for (uint32_t i = 0; i < filters.size(); i++) {
+			auto instance = osn::Filter::constructor.New({Napi::Number::New(info.Env(), filters[i])});
 			array.Set(i, instance);
 		}
 		return array;
@@ -567,23 +593,23 @@ Napi::Value osn::Input::Filters(const Napi::CallbackInfo &info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	std::vector<uint64_t> *filters;
-	if (sdi) {
-		filters = sdi->filters;
-		filters->clear();
-	}
+	if (sdi)
+		sdi->filters.clear();
 
-	Napi::Array array = Napi::Array::New(info.Env(), response.size() - 1);
-	for (size_t idx = 1; idx < response.size(); idx++) {
+	// The reply starts with the version of the source the filters belong to.
+	Napi::Array array = Napi::Array::New(info.Env(), response.size() - 2);
+	for (size_t idx = 2; idx < response.size(); idx++) {
 		auto instance = osn::Filter::constructor.New({Napi::Number::New(info.Env(), response[idx].value_union.ui64)});
-		array.Set(uint32_t(idx) - 1, instance);
+		array.Set(uint32_t(idx) - 2, instance);
 
 		if (sdi)
-			filters->push_back(response[idx].value_union.ui64);
+			sdi->filters.push_back(response[idx].value_union.ui64);
 	}
 
-	if (sdi)
+	if (sdi) {
 		sdi->filtersOrderChanged = false;
+		sdi->filtersVersion = std::max(sdi->filtersVersion, response[1].value_union.ui64);
+	}
 
 	return array;
 }
@@ -597,7 +623,7 @@ Napi::Value osn::Input::AddFilter(const Napi::CallbackInfo &info)
 		return info.Env().Undefined();
 
 	conn->call("Input", "AddFilter", {ipc::value(this->sourceId), ipc::value(objfilter->sourceId)});
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi) {
 		sdi->filtersOrderChanged = true;
 	}
@@ -614,7 +640,7 @@ Napi::Value osn::Input::RemoveFilter(const Napi::CallbackInfo &info)
 
 	conn->call("Input", "RemoveFilter", {ipc::value(this->sourceId), ipc::value(objfilter->sourceId)});
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi) {
 		sdi->filtersOrderChanged = true;
 	}
@@ -632,7 +658,7 @@ Napi::Value osn::Input::SetFilterOrder(const Napi::CallbackInfo &info)
 
 	conn->call("Input", "MoveFilter", {ipc::value(this->sourceId), ipc::value(objfilter->sourceId), ipc::value(movement)});
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi) {
 		sdi->filtersOrderChanged = true;
 	}
@@ -680,18 +706,27 @@ Napi::Value osn::Input::CallGetProperties(const Napi::CallbackInfo &info)
 {
 	Napi::Value ret = osn::ISource::GetProperties(info, this->sourceId);
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi && sdi->obs_sourceId.compare("game_capture") == 0) {
 		sdi->propertiesChanged = true;
 	}
 	return ret;
 }
 
+Napi::Value osn::Input::CallGetPropertiesAsync(const Napi::CallbackInfo &info)
+{
+	// Game capture properties list the running windows, they are never cached.
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
+	bool cacheable = !(sdi && sdi->obs_sourceId.compare("game_capture") == 0);
+
+	return osn::ISource::GetPropertiesAsync(info, this->sourceId, cacheable);
+}
+
 Napi::Value osn::Input::CallGetSettings(const Napi::CallbackInfo &info)
 {
 	Napi::Value ret = osn::ISource::GetSettings(info, this->sourceId);
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi && sdi->obs_sourceId.compare("screen_capture") == 0) {
 		sdi->settingsChanged = true;
 	}
@@ -787,7 +822,7 @@ Napi::Value osn::Input::CallUpdate(const Napi::CallbackInfo &info)
 {
 	osn::ISource::Update(info, this->sourceId);
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(this->sourceId);
 	if (sdi && sdi->obs_sourceId.compare("screen_capture") == 0) {
 		sdi->settingsChanged = true;
 	}
@@ -18,7 +18,9 @@
 
 #include "isource.hpp"
 #include "osn-error.hpp"
+#include <algorithm>
 #include <functional>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "shared.hpp"
 #include "utility-v8.hpp"
@@ -62,20 +64,53 @@ Napi::Value osn::ISource::IsConfigurable(const Napi::CallbackInfo &info, uint64_
 	return Napi::Boolean::New(info.Env(), (bool)response[1].value_union.i32);
 }
 
+static Napi::Value PropertiesFromMap(Napi::Env env, const osn::property_map_t &pmap, uint64_t id)
+{
+	std::shared_ptr<osn::property_map_t> pSomeObject = std::make_shared<osn::property_map_t>(pmap);
+	auto prop_ptr = Napi::External<osn::property_map_t>::New(env, pSomeObject.get());
+	auto instance = osn::Properties::constructor.New({prop_ptr, Napi::Number::New(env, id)});
+	return instance;
+}
+
+// Cached properties of the source, or an empty value if they must be fetched.
+static Napi::Value CachedProperties(Napi::Env env, uint64_t id)
+{
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+
+	if (sdi && !sdi->propertiesChanged && sdi->properties.size() > 0)
+		return PropertiesFromMap(env, sdi->properties, id);
+	return Napi::Value();
+}
+
+static Napi::Value PropertiesFromResponse(Napi::Env env, uint64_t id, std::vector<ipc::value> &response, bool cacheable)
+{
+	if (!ValidateResponse(env, response))
+		return env.Undefined();
+
+	// The reply starts with the version of the source the properties belong to.
+	if (response.size() <= 2)
+		return env.Null();
+
+	osn::property_map_t pmap = osn::ProcessProperties(response, 2);
+
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+	if (sdi && cacheable) {
+		sdi->properties = pmap;
+		sdi->propertiesChanged = false;
+		sdi->propertiesVersion = std::max(sdi->propertiesVersion, response[1].value_union.ui64);
+	}
+	return PropertiesFromMap(env, pmap, id);
+}
+
 Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo &info, uint64_t id)
 {
 	osn::ISource *source = Napi::ObjectWrap<osn::ISource>::Unwrap(info.This().ToObject());
 	if (!source)
 		return info.Env().Undefined();
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
-
-	if (sdi && !sdi->propertiesChanged && sdi->properties.size() > 0) {
-		std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(sdi->properties);
-		auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
-		auto instance = osn::Properties::constructor.New({prop_ptr, Napi::Number::New(info.Env(), (uint32_t)id)});
-		return instance;
-	}
+	Napi::Value cached = CachedProperties(info.Env(), id);
+	if (!cached.IsEmpty())
+		return cached;
 
 	auto conn = GetConnection(info);
 	if (!conn)
@@ -83,22 +118,21 @@ Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo &info, uint64_t
 
 	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetProperties", {ipc::value(id)});
 
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	if (response.size() == 1)
-		return info.Env().Null();
-
-	osn::property_map_t pmap = osn::ProcessProperties(response, 1);
+	return PropertiesFromResponse(info.Env(), id, response, true);
+}
 
-	if (sdi) {
-		sdi->properties = pmap;
-		sdi->propertiesChanged = false;
+Napi::Value osn::ISource::GetPropertiesAsync(const Napi::CallbackInfo &info, uint64_t id, bool cacheable)
+{
+	Napi::Value cached = cacheable ? CachedProperties(info.Env(), id) : Napi::Value();
+	if (!cached.IsEmpty()) {
+		Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
+		deferred.Resolve(cached);
+		return deferred.Promise();
 	}
-	std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(pmap);
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
-	auto instance = osn::Properties::constructor.New({prop_ptr, Napi::Number::New(info.Env(), (uint32_t)id)});
-	return instance;
+
+	return async::Call(info.Env(), "Source", "GetProperties", {ipc::value(id)}, [id, cacheable](Napi::Env env, std::vector<ipc::value> &response) {
+		return PropertiesFromResponse(env, id, response, cacheable);
+	});
 }
 
 Napi::Value osn::ISource::GetSlowUncachedSettings(const Napi::CallbackInfo &info, uint64_t id)
@@ -134,7 +168,7 @@ Napi::Value osn::ISource::GetSettings(const Napi::CallbackInfo &info, uint64_t i
 	Napi::Object json = info.Env().Global().Get("JSON").As<Napi::Object>();
 	Napi::Function parse = json.Get("parse").As<Napi::Function>();
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
 
 	if (sdi && !sdi->settingsChanged && sdi->setting.size() > 0) {
 		Napi::String jsondata = Napi::String::New(info.Env(), sdi->setting);
@@ -157,6 +191,8 @@ Napi::Value osn::ISource::GetSettings(const Napi::CallbackInfo &info, uint64_t i
 	if (sdi) {
 		sdi->setting = response[1].value_str;
 		sdi->settingsChanged = false;
+		if (response.size() > 2)
+			sdi->settingsVersion = std::max(sdi->settingsVersion, response[2].value_union.ui64);
 	}
 
 	return jsonObj;
@@ -172,7 +208,7 @@ void osn::ISource::Update(const Napi::CallbackInfo &info, uint64_t id)
 
 	std::string jsondata = stringify.Call(json, {jsonObj}).As<Napi::String>();
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
 
 	if (sdi && sdi->setting.size() > 0) {
 		auto newSettings = nlohmann::json::parse(jsondata);
@@ -204,6 +240,8 @@ void osn::ISource::Update(const Napi::CallbackInfo &info, uint64_t id)
 			sdi->setting = response[1].value_str;
 			sdi->settingsChanged = false;
 			sdi->propertiesChanged = true;
+			if (response.size() > 2)
+				sdi->settingsVersion = std::max(sdi->settingsVersion, response[2].value_union.ui64);
 		}
 	}
 }
@@ -250,7 +288,7 @@ Napi::Value osn::ISource::GetName(const Napi::CallbackInfo &info, uint64_t id)
 	if (!source)
 		return info.Env().Undefined();
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
 
 	if (sdi) {
 		if (sdi->name.size() > 0) {
@@ -363,7 +401,7 @@ Napi::Value osn::ISource::GetId(const Napi::CallbackInfo &info, uint64_t id)
 	if (!source)
 		return info.Env().Undefined();
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
 
 	if (sdi) {
 		if (sdi->obs_sourceId.size() > 0)
@@ -392,7 +430,7 @@ Napi::Value osn::ISource::GetMuted(const Napi::CallbackInfo &info, uint64_t id)
 	if (!source)
 		return info.Env().Undefined();
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
 
 	if (sdi) {
 		if (sdi && !sdi->mutedChanged)
@@ -430,7 +468,7 @@ void osn::ISource::SetMuted(const Napi::CallbackInfo &info, const Napi::Value &v
 
 	conn->call("Source", "SetMuted", {ipc::value(id), ipc::value(muted)});
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(id);
 	if (sdi)
 		sdi->mutedChanged = true;
 }
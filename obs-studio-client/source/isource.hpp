@@ -44,6 +44,7 @@ public:
 
 	static Napi::Value IsConfigurable(const Napi::CallbackInfo &info, uint64_t id);
 	static Napi::Value GetProperties(const Napi::CallbackInfo &info, uint64_t id);
+	static Napi::Value GetPropertiesAsync(const Napi::CallbackInfo &info, uint64_t id, bool cacheable = true);
 	static Napi::Value GetSettings(const Napi::CallbackInfo &info, uint64_t id);
 	static Napi::Value GetSlowUncachedSettings(const Napi::CallbackInfo &info, uint64_t id);
 
@@ -19,6 +19,10 @@
 #include "controller.hpp"
 #include "osn-error.hpp"
 #include "nodeobs_api.hpp"
+#include "cache-manager.hpp"
+#include "call-stats.hpp"
+#include "call-trace.hpp"
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include "shared.hpp"
@@ -63,6 +67,10 @@ Napi::Value api::OBS_API_initAPI(const Napi::CallbackInfo &info)
 		}
 	}
 
+	// Settings, properties and filters changed on the server side mark the
+	// cached copies as changed.
+	cache::SubscribeSourceInvalidations();
+
 	return Napi::Number::New(info.Env(), response[1].value_union.i32);
 }
 
@@ -72,6 +80,7 @@ Napi::Value api::OBS_API_destroyOBS_API(const Napi::CallbackInfo &info)
 	if (!conn)
 		return info.Env().Undefined();
 
+	cache::UnsubscribeSourceInvalidations();
 	conn->call("API", "OBS_API_destroyOBS_API", {});
 
 #ifdef __APPLE__
@@ -555,6 +564,208 @@ Napi::Value api::GetForceGPURenderingLegacy(const Napi::CallbackInfo &info)
 	return Napi::Boolean::New(info.Env(), response[1].value_union.ui32);
 }
 
+Napi::Value api::GetSetterCoalescing(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Coalescer", "IsEnabled", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return Napi::Boolean::New(info.Env(), response[1].value_union.ui32);
+}
+
+void api::SetSetterCoalescing(const Napi::CallbackInfo &info)
+{
+	bool enabled = info[0].ToBoolean().Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Coalescer", "SetEnabled", {ipc::value(uint32_t(enabled))});
+
+	ValidateResponse(info, response);
+}
+
+void api::SetServerProfiling(const Napi::CallbackInfo &info)
+{
+	bool enabled = info[0].ToBoolean().Value();
+	uint32_t logInterval = info.Length() > 1 && info[1].IsNumber() ? info[1].ToNumber().Uint32Value() : 0;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Profiler", "SetEnabled", {ipc::value(uint32_t(enabled))});
+	if (!ValidateResponse(info, response))
+		return;
+
+	response = conn->call_synchronous_helper("Profiler", "SetLogInterval", {ipc::value(enabled ? logInterval : 0)});
+	ValidateResponse(info, response);
+}
+
+Napi::Value api::GetServerProfile(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Profiler", "GetStatistics", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	uint32_t count = response[1].value_union.ui32;
+	Napi::Array functions = Napi::Array::New(info.Env(), count);
+	for (uint32_t idx = 0; idx < count; idx++) {
+		size_t offset = 2 + size_t(idx) * 10;
+		if (response.size() < offset + 10)
+			break;
+
+		Napi::Object function = Napi::Object::New(info.Env());
+		function.Set("name", Napi::String::New(info.Env(), response[offset].value_str));
+		function.Set("calls", Napi::Number::New(info.Env(), double(response[offset + 1].value_union.ui64)));
+		function.Set("errors", Napi::Number::New(info.Env(), double(response[offset + 2].value_union.ui64)));
+		function.Set("totalUs", Napi::Number::New(info.Env(), double(response[offset + 3].value_union.ui64)));
+		function.Set("maxUs", Napi::Number::New(info.Env(), double(response[offset + 4].value_union.ui64)));
+		function.Set("p50Us", Napi::Number::New(info.Env(), double(response[offset + 5].value_union.ui64)));
+		function.Set("p90Us", Napi::Number::New(info.Env(), double(response[offset + 6].value_union.ui64)));
+		function.Set("p99Us", Napi::Number::New(info.Env(), double(response[offset + 7].value_union.ui64)));
+		function.Set("argBytes", Napi::Number::New(info.Env(), double(response[offset + 8].value_union.ui64)));
+		function.Set("replyBytes", Napi::Number::New(info.Env(), double(response[offset + 9].value_union.ui64)));
+		functions.Set(idx, function);
+	}
+	return functions;
+}
+
+void api::ResetServerProfile(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Profiler", "Reset", {});
+
+	ValidateResponse(info, response);
+}
+
+Napi::Value api::GetMediaCacheState(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("MemoryManager", "GetCacheState", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Object state = Napi::Object::New(info.Env());
+	state.Set("cachedBytes", Napi::Number::New(info.Env(), double(response[1].value_union.ui64)));
+	state.Set("allowedBytes", Napi::Number::New(info.Env(), double(response[2].value_union.ui64)));
+	state.Set("totalMemory", Napi::Number::New(info.Env(), double(response[3].value_union.ui64)));
+	state.Set("availableMemory", Napi::Number::New(info.Env(), double(response[4].value_union.ui64)));
+
+	uint32_t count = response[5].value_union.ui32;
+	Napi::Array sources = Napi::Array::New(info.Env(), count);
+	for (uint32_t idx = 0; idx < count; idx++) {
+		size_t offset = 6 + size_t(idx) * 5;
+		if (response.size() < offset + 5)
+			break;
+
+		Napi::Object source = Napi::Object::New(info.Env());
+		source.Set("name", Napi::String::New(info.Env(), response[offset].value_str));
+		source.Set("size", Napi::Number::New(info.Env(), double(response[offset + 1].value_union.ui64)));
+		source.Set("cached", Napi::Boolean::New(info.Env(), response[offset + 2].value_union.ui32));
+		source.Set("showing", Napi::Boolean::New(info.Env(), response[offset + 3].value_union.ui32));
+		uint64_t lastShown = response[offset + 4].value_union.ui64;
+		source.Set("lastShownMs", lastShown == UINT64_MAX ? info.Env().Null() : Napi::Number::New(info.Env(), double(lastShown)));
+		sources.Set(idx, source);
+	}
+	state.Set("sources", sources);
+	return state;
+}
+
+void api::SetLogRateLimit(const Napi::CallbackInfo &info)
+{
+	uint32_t windowMs = info[0].ToNumber().Uint32Value();
+	uint32_t burst = info[1].ToNumber().Uint32Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("LogLimiter", "SetThresholds", {ipc::value(windowMs), ipc::value(burst)});
+
+	ValidateResponse(info, response);
+}
+
+Napi::Value api::GetLogRateLimit(const Napi::CallbackInfo &info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("LogLimiter", "GetThresholds", {});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Object limit = Napi::Object::New(info.Env());
+	limit.Set("windowMs", Napi::Number::New(info.Env(), response[1].value_union.ui32));
+	limit.Set("burst", Napi::Number::New(info.Env(), response[2].value_union.ui32));
+	limit.Set("suppressed", Napi::Number::New(info.Env(), double(response[3].value_union.ui64)));
+	return limit;
+}
+
+Napi::Value api::GetLogReport(const Napi::CallbackInfo &info)
+{
+	// GetLogReport('errors' | 'warnings' | 'general', since?, count?)
+	static const std::vector<std::string> levels = {"errors", "warnings", "general"};
+	std::string levelName = info[0].ToString().Utf8Value();
+	auto level = std::find(levels.begin(), levels.end(), levelName);
+	if (level == levels.end()) {
+		Napi::TypeError::New(info.Env(), "Invalid log level, expected 'errors', 'warnings' or 'general'.").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+	uint64_t since = info.Length() > 1 && info[1].IsNumber() ? uint64_t(info[1].ToNumber().Int64Value()) : 0;
+	uint32_t count = info.Length() > 2 && info[2].IsNumber() ? info[2].ToNumber().Uint32Value() : UINT32_MAX;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+		conn->call_synchronous_helper("API", "GetLogReport", {ipc::value(uint32_t(level - levels.begin())), ipc::value(since), ipc::value(count)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Object report = Napi::Object::New(info.Env());
+	report.Set("total", Napi::Number::New(info.Env(), double(response[1].value_union.ui64)));
+	report.Set("lastSequence", Napi::Number::New(info.Env(), double(response[2].value_union.ui64)));
+
+	uint32_t entryCount = response[3].value_union.ui32;
+	Napi::Array entries = Napi::Array::New(info.Env(), entryCount);
+	for (uint32_t idx = 0; idx < entryCount; idx++) {
+		size_t offset = 4 + size_t(idx) * 3;
+		if (response.size() < offset + 3)
+			break;
+
+		Napi::Object entry = Napi::Object::New(info.Env());
+		entry.Set("sequence", Napi::Number::New(info.Env(), double(response[offset].value_union.ui64)));
+		entry.Set("level", Napi::Number::New(info.Env(), response[offset + 1].value_union.i32));
+		entry.Set("message", Napi::String::New(info.Env(), response[offset + 2].value_str));
+		entries.Set(idx, entry);
+	}
+	report.Set("entries", entries);
+	return report;
+}
+
 void api::Init(Napi::Env env, Napi::Object exports)
 {
 	exports.Set(Napi::String::New(env, "OBS_API_initAPI"), Napi::Function::New(env, api::OBS_API_initAPI));
@@ -589,4 +800,20 @@ void api::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(Napi::String::New(env, "GetForceGPURendering"), Napi::Function::New(env, api::GetForceGPURendering));
 	exports.Set(Napi::String::New(env, "SetForceGPURendering"), Napi::Function::New(env, api::SetForceGPURendering));
 	exports.Set(Napi::String::New(env, "GetForceGPURenderingLegacy"), Napi::Function::New(env, api::GetForceGPURenderingLegacy));
+	exports.Set(Napi::String::New(env, "GetSetterCoalescing"), Napi::Function::New(env, api::GetSetterCoalescing));
+	exports.Set(Napi::String::New(env, "SetSetterCoalescing"), Napi::Function::New(env, api::SetSetterCoalescing));
+	exports.Set(Napi::String::New(env, "SetServerProfiling"), Napi::Function::New(env, api::SetServerProfiling));
+	exports.Set(Napi::String::New(env, "GetServerProfile"), Napi::Function::New(env, api::GetServerProfile));
+	exports.Set(Napi::String::New(env, "ResetServerProfile"), Napi::Function::New(env, api::ResetServerProfile));
+	exports.Set(Napi::String::New(env, "GetMediaCacheState"), Napi::Function::New(env, api::GetMediaCacheState));
+	exports.Set(Napi::String::New(env, "SetLogRateLimit"), Napi::Function::New(env, api::SetLogRateLimit));
+	exports.Set(Napi::String::New(env, "GetLogRateLimit"), Napi::Function::New(env, api::GetLogRateLimit));
+	exports.Set(Napi::String::New(env, "GetLogReport"), Napi::Function::New(env, api::GetLogReport));
+	exports.Set(Napi::String::New(env, "SetClientProfiling"), Napi::Function::New(env, callstats::SetEnabled));
+	exports.Set(Napi::String::New(env, "GetClientProfile"), Napi::Function::New(env, callstats::GetStatistics));
+	exports.Set(Napi::String::New(env, "ResetClientProfile"), Napi::Function::New(env, callstats::Reset));
+	exports.Set(Napi::String::New(env, "StartCallTrace"), Napi::Function::New(env, calltrace::JSStart));
+	exports.Set(Napi::String::New(env, "StopCallTrace"), Napi::Function::New(env, calltrace::JSStop));
+	exports.Set(Napi::String::New(env, "GetCacheStatistics"), Napi::Function::New(env, cache::GetStatistics));
+	exports.Set(Napi::String::New(env, "SetCacheCapacity"), Napi::Function::New(env, cache::SetCapacity));
 }
@@ -61,4 +61,14 @@ Napi::Value GetHdrNominalPeakLevelLegacy(const Napi::CallbackInfo &info);
 Napi::Value GetLowLatencyAudioBuffering(const Napi::CallbackInfo &info);
 void SetLowLatencyAudioBuffering(const Napi::CallbackInfo &info);
 Napi::Value GetLowLatencyAudioBufferingLegacy(const Napi::CallbackInfo &info);
+
+Napi::Value GetSetterCoalescing(const Napi::CallbackInfo &info);
+void SetSetterCoalescing(const Napi::CallbackInfo &info);
+void SetServerProfiling(const Napi::CallbackInfo &info);
+Napi::Value GetServerProfile(const Napi::CallbackInfo &info);
+void ResetServerProfile(const Napi::CallbackInfo &info);
+Napi::Value GetMediaCacheState(const Napi::CallbackInfo &info);
+void SetLogRateLimit(const Napi::CallbackInfo &info);
+Napi::Value GetLogRateLimit(const Napi::CallbackInfo &info);
+Napi::Value GetLogReport(const Napi::CallbackInfo &info);
 }
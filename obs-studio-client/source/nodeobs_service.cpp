@@ -18,6 +18,7 @@
 
 #include "nodeobs_service.hpp"
 #include "controller.hpp"
+#include "event-channel.hpp"
 #include "osn-error.hpp"
 #include "utility-v8.hpp"
 
@@ -39,25 +40,78 @@ enum VcamInstalledStatus : uint8_t { NotInstalled = 0, LegacyInstalled = 1, Inst
 #endif
 
 bool service::isWorkerRunning = false;
-bool service::worker_stop = true;
-uint32_t service::sleepIntervalMS = 33;
-std::thread *service::worker_thread = nullptr;
 Napi::ThreadSafeFunction service::js_thread;
 Napi::FunctionReference service::cb;
 
-void service::start_worker(napi_env env, Napi::Function async_callback)
+static void signal_callback(Napi::Env env, Napi::Function jsCallback, std::vector<ServiceSignalInfo> *data)
 {
-	if (isWorkerRunning)
+	for (auto &signal : *data) {
+		try {
+			Napi::Object result = Napi::Object::New(env);
+
+			result.Set(Napi::String::New(env, "type"), Napi::String::New(env, signal.outputType));
+			result.Set(Napi::String::New(env, "signal"), Napi::String::New(env, signal.signal));
+			result.Set(Napi::String::New(env, "code"), Napi::Number::New(env, signal.code));
+			result.Set(Napi::String::New(env, "error"), Napi::String::New(env, signal.errorMessage));
+			result.Set(Napi::String::New(env, "service"), Napi::String::New(env, service::getServiceNameById(signal.service)));
+
+			jsCallback.Call({result});
+		} catch (...) {
+		}
+	}
+	delete data;
+}
+
+// Signals are handed to JS in one call to the thread safe function per batch.
+static void send_service_signals(std::vector<ServiceSignalInfo> *signals)
+{
+	if (signals->empty()) {
+		delete signals;
 		return;
+	}
+
+	napi_status status = service::js_thread.NonBlockingCall(signals, signal_callback);
+	if (status != napi_ok)
+		delete signals;
+}
+
+static void on_service_signals(const std::vector<const EventChannel::Event *> &events)
+{
+	std::vector<ServiceSignalInfo> *signals = new std::vector<ServiceSignalInfo>();
+	for (auto event : events) {
+		const std::vector<ipc::value> &values = event->values;
+		if (values.size() < 5)
+			continue;
 
-	if (!worker_stop)
+		signals->push_back({values[0].value_str, values[1].value_str, values[2].value_union.i32, values[3].value_str, values[4].value_union.i32});
+	}
+	send_service_signals(signals);
+}
+
+void service::start_worker(napi_env env, Napi::Function async_callback)
+{
+	if (isWorkerRunning)
 		return;
 
-	worker_stop = false;
 	js_thread = Napi::ThreadSafeFunction::New(env, async_callback, "NodeOBS_Service", 0, 1, [](Napi::Env) {});
-	worker_thread = new std::thread(&service::worker);
+	EventChannel::GetInstance().Subscribe(osn::EventType::ServiceSignal, &js_thread, on_service_signals);
 
 	isWorkerRunning = true;
+
+	// Deliver what was queued on the server while nobody listened.
+	auto conn = Controller::GetInstance().GetConnection();
+	if (!conn)
+		return;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("NodeOBS_Service", "Query", {});
+	if (response.size() < 2 || response[0].type == ipc::type::Null || (ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok)
+		return;
+
+	std::vector<ServiceSignalInfo> *signals = new std::vector<ServiceSignalInfo>();
+	for (size_t index = 2; index + 5 <= response.size(); index += 5)
+		signals->push_back({response[index].value_str, response[index + 1].value_str, response[index + 2].value_union.i32,
+				    response[index + 3].value_str, response[index + 4].value_union.i32});
+	send_service_signals(signals);
 }
 
 void service::stop_worker(void)
@@ -65,13 +119,8 @@ void service::stop_worker(void)
 	if (!isWorkerRunning)
 		return;
 
-	if (worker_stop != false)
-		return;
-
-	worker_stop = true;
-	if (worker_thread->joinable()) {
-		worker_thread->join();
-	}
+	EventChannel::GetInstance().Unsubscribe(osn::EventType::ServiceSignal, &js_thread);
+	js_thread.Release();
 
 	isWorkerRunning = false;
 }
@@ -279,80 +328,6 @@ std::string service::getServiceNameById(int serviceId)
 	return "default";
 }
 
-void service::worker()
-{
-	const static int maximum_signals_in_queue = 100;
-	auto callback = [](Napi::Env env, Napi::Function jsCallback, ServiceSignalInfo *data) {
-		try {
-			Napi::Object result = Napi::Object::New(env);
-
-			result.Set(Napi::String::New(env, "type"), Napi::String::New(env, data->outputType));
-			result.Set(Napi::String::New(env, "signal"), Napi::String::New(env, data->signal));
-			result.Set(Napi::String::New(env, "code"), Napi::Number::New(env, data->code));
-			result.Set(Napi::String::New(env, "error"), Napi::String::New(env, data->errorMessage));
-			result.Set(Napi::String::New(env, "service"), Napi::String::New(env, getServiceNameById(data->service)));
-
-			jsCallback.Call({result});
-		} catch (...) {
-			data->tosend = true;
-			return;
-		}
-		data->sent = true;
-	};
-	size_t totalSleepMS = 0;
-	std::vector<ServiceSignalInfo *> signalsList;
-	while (!worker_stop) {
-		auto tp_start = std::chrono::high_resolution_clock::now();
-
-		// Validate Connection
-		auto conn = Controller::GetInstance().GetConnection();
-		if (conn) {
-			std::vector<ipc::value> response = conn->call_synchronous_helper("NodeOBS_Service", "Query", {});
-			if ((response.size() == 6) && signalsList.size() < maximum_signals_in_queue) {
-				ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-				if (error == ErrorCode::Ok) {
-					ServiceSignalInfo *data = new ServiceSignalInfo{"", "", 0, ""};
-					data->outputType = response[1].value_str;
-					data->signal = response[2].value_str;
-					data->code = response[3].value_union.i32;
-					data->errorMessage = response[4].value_str;
-					data->service = response[5].value_union.i32;
-					data->sent = false;
-					data->tosend = true;
-					signalsList.push_back(data);
-				}
-			}
-
-			std::vector<ServiceSignalInfo *>::iterator i = signalsList.begin();
-			while (i != signalsList.end()) {
-				if ((*i)->tosend) {
-					(*i)->tosend = false;
-					napi_status status = js_thread.BlockingCall((*i), callback);
-					if (status != napi_ok) {
-						(*i)->tosend = true;
-						break;
-					}
-				}
-				if ((*i)->sent) {
-					i = signalsList.erase(i);
-				} else {
-					i++;
-				}
-			}
-		}
-
-		auto tp_end = std::chrono::high_resolution_clock::now();
-		auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
-		totalSleepMS = sleepIntervalMS - dur.count();
-		std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
-	}
-
-	for (auto &signalData : signalsList) {
-		delete signalData;
-	}
-	return;
-}
-
 Napi::Value service::OBS_service_removeCallback(const Napi::CallbackInfo &info)
 {
 	stop_worker();
@@ -27,21 +27,14 @@ struct ServiceSignalInfo {
 	int code;
 	std::string errorMessage;
 	int service;
-
-	bool sent;
-	bool tosend;
 };
 
 namespace service {
 
 extern bool isWorkerRunning;
-extern bool worker_stop;
-extern uint32_t sleepIntervalMS;
-extern std::thread *worker_thread;
 extern Napi::ThreadSafeFunction js_thread;
 extern Napi::FunctionReference cb;
 
-void worker(void);
 void start_worker(napi_env env, Napi::Function async_callback);
 void stop_worker(void);
 
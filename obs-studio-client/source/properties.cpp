@@ -47,7 +47,7 @@ osn::Properties::Properties(const Napi::CallbackInfo &info) : Napi::ObjectWrap<o
 	Napi::Env env = info.Env();
 	Napi::HandleScope scope(env);
 	this->properties = std::make_shared<property_map_t>(*info[0].As<const Napi::External<property_map_t>>().Data());
-	this->sourceId = (uint64_t)info[1].ToNumber().Uint32Value();
+	this->sourceId = (uint64_t)info[1].ToNumber().Int64Value();
 }
 
 Napi::Value osn::Properties::Count(const Napi::CallbackInfo &info)
@@ -182,7 +182,7 @@ Napi::Value osn::PropertyObject::Next(const Napi::CallbackInfo &info)
 		return info.Env().Undefined();
 
 	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), parent->properties.get());
-	auto obj = osn::Properties::constructor.New({prop_ptr, Napi::Number::New(info.Env(), (uint32_t)parent->sourceId)});
+	auto obj = osn::Properties::constructor.New({prop_ptr, Napi::Number::New(info.Env(), parent->sourceId)});
 
 	auto instance = osn::PropertyObject::constructor.New({obj, Napi::Number::New(info.Env(), (uint32_t)iter->first)});
 	return instance;
@@ -548,7 +548,7 @@ Napi::Value osn::PropertyObject::Modified(const Napi::CallbackInfo &info)
 	if (!ValidateResponse(info, rval))
 		return Napi::Boolean::New(info.Env(), false);
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(parent->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(parent->sourceId);
 	if (sdi) {
 		sdi->propertiesChanged = true;
 		sdi->settingsChanged = true;
@@ -585,7 +585,7 @@ Napi::Value osn::PropertyObject::ButtonClicked(const Napi::CallbackInfo &info)
 	if (ValidateResponse(info, rval))
 		settings_changed = true;
 
-	SourceDataInfo *sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(parent->sourceId);
+	std::shared_ptr<SourceDataInfo> sdi = CacheManager<SourceDataInfo *>::getInstance().Retrieve(parent->sourceId);
 	if (sdi) {
 		sdi->propertiesChanged = true;
 		sdi->settingsChanged = settings_changed;
@@ -18,6 +18,7 @@
 
 #include "recording.hpp"
 #include "utility.hpp"
+#include "async-call.hpp"
 #include "video-encoder.hpp"
 
 Napi::Value osn::Recording::GetVideoEncoder(const Napi::CallbackInfo &info)
@@ -96,6 +97,29 @@ void osn::Recording::Stop(const Napi::CallbackInfo &info)
 	conn->call(className, "Stop", {ipc::value(this->uid), ipc::value(force)});
 }
 
+static Napi::Value Acknowledge(Napi::Env env, std::vector<ipc::value> &response)
+{
+	ValidateResponse(env, response);
+	return env.Undefined();
+}
+
+// Starting and stopping the same output are kept in order.
+Napi::Value osn::Recording::StartAsync(const Napi::CallbackInfo &info)
+{
+	startWorker(info.Env(), this->cb.Value(), className, this->uid);
+
+	return async::Call(info.Env(), className, "Start", {ipc::value(this->uid)}, Acknowledge);
+}
+
+Napi::Value osn::Recording::StopAsync(const Napi::CallbackInfo &info)
+{
+	bool force = false;
+	if (info.Length() == 1)
+		force = info[0].ToBoolean().Value();
+
+	return async::Call(info.Env(), className, "Stop", {ipc::value(this->uid), ipc::value(force)}, Acknowledge);
+}
+
 void osn::Recording::SplitFile(const Napi::CallbackInfo &info)
 {
 	auto conn = GetConnection(info);
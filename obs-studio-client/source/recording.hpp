@@ -24,7 +24,7 @@
 namespace osn {
 class Recording : public WorkerSignals, public FileOutput {
 public:
-	Recording() : WorkerSignals(), FileOutput(){};
+	Recording() : WorkerSignals("recording"), FileOutput(){};
 
 protected:
 	Napi::Function signalHandler;
@@ -47,6 +47,8 @@ protected:
 
 	void Start(const Napi::CallbackInfo &info);
 	void Stop(const Napi::CallbackInfo &info);
+	Napi::Value StartAsync(const Napi::CallbackInfo &info);
+	Napi::Value StopAsync(const Napi::CallbackInfo &info);
 	void SplitFile(const Napi::CallbackInfo &info);
 };
 }
\ No newline at end of file
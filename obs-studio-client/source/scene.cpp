@@ -20,8 +20,10 @@
 #include <condition_variable>
 #include <mutex>
 #include <string>
+#include "async-call.hpp"
 #include "controller.hpp"
 #include "osn-error.hpp"
+#include "osn-scene-snapshot.hpp"
 #include "input.hpp"
 #include "video.hpp"
 #include "ipc-value.hpp"
@@ -49,10 +51,13 @@ Napi::Object osn::Scene::Init(Napi::Env env, Napi::Object exports)
 						  InstanceMethod("orderItems", &osn::Scene::OrderItems),
 						  InstanceMethod("getItemAtIdx", &osn::Scene::GetItemAtIndex),
 						  InstanceMethod("getItems", &osn::Scene::GetItems),
+						  InstanceMethod("getItemsAsync", &osn::Scene::GetItemsAsync),
 						  InstanceMethod("getItemsInRange", &osn::Scene::GetItemsInRange),
+						  InstanceMethod("applyTransforms", &osn::Scene::ApplyTransforms),
 
 						  InstanceAccessor("configurable", &osn::Scene::CallIsConfigurable, nullptr),
 						  InstanceAccessor("properties", &osn::Scene::CallGetProperties, nullptr),
+						  InstanceMethod("getPropertiesAsync", &osn::Scene::CallGetPropertiesAsync),
 						  InstanceAccessor("settings", &osn::Scene::CallGetSettings, nullptr),
 						  InstanceAccessor("slowUncachedSettings", &osn::Scene::CallGetSlowUncachedSettings, nullptr),
 						  InstanceAccessor("type", &osn::Scene::CallGetType, nullptr),
@@ -161,7 +166,7 @@ Napi::Value osn::Scene::CreatePrivate(const Napi::CallbackInfo &info)
 Napi::Value osn::Scene::FromName(const Napi::CallbackInfo &info)
 {
 	std::string name = info[0].ToString().Utf8Value();
-	SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(name);
+	std::shared_ptr<SceneInfo> si = CacheManager<SceneInfo *>::getInstance().Retrieve(name);
 
 	if (!si) {
 		auto conn = GetConnection(info);
@@ -291,7 +296,7 @@ Napi::Value osn::Scene::AddSource(const Napi::CallbackInfo &info)
 	uint64_t id = response[1].value_union.ui64;
 	int64_t obs_id = response[2].value_union.i64;
 
-	SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SceneInfo> si = CacheManager<SceneInfo *>::getInstance().Retrieve(this->sourceId);
 
 	if (si) {
 		si->items.push_back(std::make_pair(obs_id, id));
@@ -373,7 +378,7 @@ Napi::Value osn::Scene::FindItem(const Napi::CallbackInfo &info)
 		return info.Env().Undefined();
 	}
 
-	SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SceneInfo> si = CacheManager<SceneInfo *>::getInstance().Retrieve(this->sourceId);
 
 	if (si && !haveName) {
 		auto find = [position](const std::pair<int64_t, uint64_t> &item) { return item.first == position; };
@@ -422,7 +427,7 @@ Napi::Value osn::Scene::MoveItem(const Napi::CallbackInfo &info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SceneInfo> si = CacheManager<SceneInfo *>::getInstance().Retrieve(this->sourceId);
 
 	if (si && response.size() > 2) {
 		si->items.clear();
@@ -460,7 +465,7 @@ Napi::Value osn::Scene::OrderItems(const Napi::CallbackInfo &info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(this->sourceId);
+	std::shared_ptr<SceneInfo> si = CacheManager<SceneInfo *>::getInstance().Retrieve(this->sourceId);
 
 	if (si && response.size() > 2) {
 		si->items.clear();
@@ -495,50 +500,92 @@ Napi::Value osn::Scene::GetItemAtIndex(const Napi::CallbackInfo &info)
 	return instance;
 }
 
-Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo &info)
+// The items of the scene if their order and every one of them are cached,
+// an empty value otherwise.
+static Napi::Value CachedItems(Napi::Env env, uint64_t sceneId)
 {
-	SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(this->sourceId);
-
-	if (si && si->itemsOrderCached) {
-		Napi::Array array = Napi::Array::New(info.Env(), int(si->items.size()) - 1);
-		size_t index = 0;
-		bool itemRemoved = false;
-
-		for (auto item : si->items) {
-			SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(item.first);
-			if (!sid) {
-				itemRemoved = true;
-				break;
-			}
-			auto instance = osn::SceneItem::constructor.New({Napi::Number::New(info.Env(), item.second)});
-			array.Set(uint32_t(index++), instance);
-		}
-		if (!itemRemoved) {
-			return array;
-		}
+	std::shared_ptr<SceneInfo> si = CacheManager<SceneInfo *>::getInstance().Retrieve(sceneId);
+	if (!si || !si->itemsOrderCached)
+		return Napi::Value();
+
+	Napi::Array array = Napi::Array::New(env, si->items.size());
+	size_t index = 0;
+
+	for (auto item : si->items) {
+		std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(item.second);
+		if (!sid)
+			return Napi::Value();
+		auto instance = osn::SceneItem::constructor.New({Napi::Number::New(env, item.second)});
+		array.Set(uint32_t(index++), instance);
 	}
+	return array;
+}
 
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
+static Napi::Value ItemsFromSnapshot(Napi::Env env, uint64_t sceneId, std::vector<ipc::value> &response)
+{
+	if (!ValidateResponse(env, response))
+		return env.Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Scene", "GetItems", std::vector<ipc::value>{ipc::value(this->sourceId)});
+	std::shared_ptr<SceneInfo> si = CacheManager<SceneInfo *>::getInstance().Retrieve(sceneId);
 
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
+	std::vector<osn::SceneItemSnapshot> items;
+	if (response.size() < 2 || !osn::read_scene_snapshot(response[1].value_bin, items)) {
+		Napi::Error::New(env, "Malformed scene snapshot.").ThrowAsJavaScriptException();
+		return env.Undefined();
+	}
 
-	Napi::Array array = Napi::Array::New(info.Env(), int((response.size()) - 1) / 2);
+	// The snapshot carries the whole state of every item, so the item cache
+	// is filled here and the getters do not need a round-trip each.
+	Napi::Array array = Napi::Array::New(env, items.size());
 	size_t index = 0;
-	for (size_t i = 1; i < response.size(); i++) {
-		auto instance = osn::SceneItem::constructor.New({Napi::Number::New(info.Env(), response[i++].value_union.ui64)});
+	for (auto &item : items) {
+		std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Peek(item.item);
+		if (!sid) {
+			sid = std::make_shared<SceneItemData>();
+			CacheManager<SceneItemData *>::getInstance().Store(item.item, sid);
+		}
+
+		sid->obs_itemId = item.obs_id;
+		sid->scene_id = sceneId;
+		sid->cached = true;
+
+		sid->isSelected = item.selected;
+		sid->selectedChanged = false;
+		sid->posX = item.pos_x;
+		sid->posY = item.pos_y;
+		sid->posChanged = false;
+		sid->scaleX = item.scale_x;
+		sid->scaleY = item.scale_y;
+		sid->scaleChanged = false;
+		sid->isVisible = item.visible;
+		sid->visibleChanged = false;
+		sid->cropLeft = item.crop_left;
+		sid->cropTop = item.crop_top;
+		sid->cropRight = item.crop_right;
+		sid->cropBottom = item.crop_bottom;
+		sid->cropChanged = false;
+		sid->rotation = item.rotation;
+		sid->rotationChanged = false;
+		sid->isStreamVisible = item.stream_visible;
+		sid->streamVisibleChanged = false;
+		sid->isRecordingVisible = item.recording_visible;
+		sid->recordingVisibleChanged = false;
+		sid->scaleFilter = item.scale_filter;
+		sid->scaleFilterChanged = false;
+		sid->blendingMode = item.blending_mode;
+		sid->blendingModeChanged = false;
+		sid->blendingMethod = item.blending_method;
+		sid->blendingMethodChanged = false;
+
+		auto instance = osn::SceneItem::constructor.New({Napi::Number::New(env, item.item)});
 		array.Set(uint32_t(index++), instance);
 	}
 
 	if (si) {
 		si->items.clear();
 
-		for (size_t i = 1; i < response.size(); i += 2) {
-			si->items.push_back(std::make_pair(response[i + 1].value_union.i64, response[i].value_union.ui64));
+		for (auto &item : items) {
+			si->items.push_back(std::make_pair(item.obs_id, item.item));
 		}
 
 		si->itemsOrderCached = true;
@@ -547,6 +594,127 @@ Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo &info)
 	return array;
 }
 
+Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo &info)
+{
+	Napi::Value cached = CachedItems(info.Env(), this->sourceId);
+	if (!cached.IsEmpty())
+		return cached;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+		conn->call_synchronous_helper("Scene", "GetItemsSnapshot", std::vector<ipc::value>{ipc::value(this->sourceId)});
+
+	return ItemsFromSnapshot(info.Env(), this->sourceId, response);
+}
+
+Napi::Value osn::Scene::GetItemsAsync(const Napi::CallbackInfo &info)
+{
+	Napi::Value cached = CachedItems(info.Env(), this->sourceId);
+	if (!cached.IsEmpty()) {
+		Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
+		deferred.Resolve(cached);
+		return deferred.Promise();
+	}
+
+	uint64_t sceneId = this->sourceId;
+	return async::Call(info.Env(), "Scene", "GetItemsSnapshot", {ipc::value(sceneId)},
+			   [sceneId](Napi::Env env, std::vector<ipc::value> &response) { return ItemsFromSnapshot(env, sceneId, response); });
+}
+
+Napi::Value osn::Scene::ApplyTransforms(const Napi::CallbackInfo &info)
+{
+	if (info.Length() != 1 || !info[0].IsArray()) {
+		Napi::TypeError::New(info.Env(), "Invalid arguments, usage: applyTransforms(<array> transforms).").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	Napi::Array array = info[0].As<Napi::Array>();
+	std::vector<osn::SceneItemTransform> transforms;
+	transforms.reserve(array.Length());
+
+	for (uint32_t idx = 0; idx < array.Length(); idx++) {
+		Napi::Value entry = array.Get(idx);
+		Napi::Value item = entry.IsObject() ? entry.ToObject().Get("item") : info.Env().Undefined();
+		if (!item.IsObject() || !item.ToObject().InstanceOf(osn::SceneItem::constructor.Value())) {
+			Napi::TypeError::New(info.Env(), "Transform " + std::to_string(idx) + " has no valid scene item.").ThrowAsJavaScriptException();
+			return info.Env().Undefined();
+		}
+
+		Napi::Object object = entry.ToObject();
+		osn::SceneItemTransform transform = {};
+		transform.item = osn::SceneItem::Unwrap(item.ToObject())->itemId;
+
+		if (object.Get("position").IsObject()) {
+			Napi::Object position = object.Get("position").ToObject();
+			transform.mask |= osn::TransformPosition;
+			transform.pos_x = position.Get("x").ToNumber().FloatValue();
+			transform.pos_y = position.Get("y").ToNumber().FloatValue();
+		}
+		if (object.Get("scale").IsObject()) {
+			Napi::Object scale = object.Get("scale").ToObject();
+			transform.mask |= osn::TransformScale;
+			transform.scale_x = scale.Get("x").ToNumber().FloatValue();
+			transform.scale_y = scale.Get("y").ToNumber().FloatValue();
+		}
+		if (object.Get("rotation").IsNumber()) {
+			transform.mask |= osn::TransformRotation;
+			transform.rotation = object.Get("rotation").ToNumber().FloatValue();
+		}
+		if (object.Get("crop").IsObject()) {
+			Napi::Object crop = object.Get("crop").ToObject();
+			transform.mask |= osn::TransformCrop;
+			transform.crop_left = crop.Get("left").ToNumber().Int32Value();
+			transform.crop_top = crop.Get("top").ToNumber().Int32Value();
+			transform.crop_right = crop.Get("right").ToNumber().Int32Value();
+			transform.crop_bottom = crop.Get("bottom").ToNumber().Int32Value();
+		}
+
+		if (transform.mask)
+			transforms.push_back(transform);
+	}
+
+	if (transforms.empty())
+		return info.Env().Undefined();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<char> buffer;
+	osn::write_scene_transforms(transforms, buffer);
+	conn->call("Scene", "ApplyTransforms", std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(buffer)});
+
+	// Like the single setters, the call is not waited on and the cached values
+	// are updated right away.
+	for (auto &transform : transforms) {
+		std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Peek(transform.item);
+		if (!sid)
+			continue;
+
+		if (transform.mask & osn::TransformPosition) {
+			sid->posX = transform.pos_x;
+			sid->posY = transform.pos_y;
+		}
+		if (transform.mask & osn::TransformScale) {
+			sid->scaleX = transform.scale_x;
+			sid->scaleY = transform.scale_y;
+		}
+		if (transform.mask & osn::TransformRotation)
+			sid->rotation = transform.rotation;
+		if (transform.mask & osn::TransformCrop) {
+			sid->cropLeft = transform.crop_left;
+			sid->cropTop = transform.crop_top;
+			sid->cropRight = transform.crop_right;
+			sid->cropBottom = transform.crop_bottom;
+		}
+	}
+
+	return info.Env().Undefined();
+}
+
 Napi::Value osn::Scene::GetItemsInRange(const Napi::CallbackInfo &info)
 {
 	int32_t from = info[0].ToNumber().Int32Value();
@@ -581,6 +749,11 @@ Napi::Value osn::Scene::CallGetProperties(const Napi::CallbackInfo &info)
 	return osn::ISource::GetProperties(info, this->sourceId);
 }
 
+Napi::Value osn::Scene::CallGetPropertiesAsync(const Napi::CallbackInfo &info)
+{
+	return osn::ISource::GetPropertiesAsync(info, this->sourceId);
+}
+
 Napi::Value osn::Scene::CallGetSettings(const Napi::CallbackInfo &info)
 {
 	return osn::ISource::GetSettings(info, this->sourceId);
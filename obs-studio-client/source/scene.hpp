@@ -47,10 +47,13 @@ public:
 	Napi::Value OrderItems(const Napi::CallbackInfo &info);
 	Napi::Value GetItemAtIndex(const Napi::CallbackInfo &info);
 	Napi::Value GetItems(const Napi::CallbackInfo &info);
+	Napi::Value GetItemsAsync(const Napi::CallbackInfo &info);
 	Napi::Value GetItemsInRange(const Napi::CallbackInfo &info);
+	Napi::Value ApplyTransforms(const Napi::CallbackInfo &info);
 
 	Napi::Value CallIsConfigurable(const Napi::CallbackInfo &info);
 	Napi::Value CallGetProperties(const Napi::CallbackInfo &info);
+	Napi::Value CallGetPropertiesAsync(const Napi::CallbackInfo &info);
 	Napi::Value CallGetSettings(const Napi::CallbackInfo &info);
 	Napi::Value CallGetSlowUncachedSettings(const Napi::CallbackInfo &info);
 
@@ -130,10 +130,10 @@ Napi::Value osn::SceneItem::Remove(const Napi::CallbackInfo &info)
 
 	conn->call("SceneItem", "Remove", std::vector<ipc::value>{ipc::value(this->itemId)});
 
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid) {
-		SceneInfo *si = CacheManager<SceneInfo *>::getInstance().Retrieve(sid->scene_id);
+		std::shared_ptr<SceneInfo> si = CacheManager<SceneInfo *>::getInstance().Retrieve(sid->scene_id);
 
 		if (si) {
 			si->itemsOrderCached = false;
@@ -146,7 +146,7 @@ Napi::Value osn::SceneItem::Remove(const Napi::CallbackInfo &info)
 
 Napi::Value osn::SceneItem::IsVisible(const Napi::CallbackInfo &info)
 {
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && !sid->visibleChanged) {
 		return Napi::Boolean::New(info.Env(), sid->isVisible);
@@ -171,7 +171,7 @@ Napi::Value osn::SceneItem::IsVisible(const Napi::CallbackInfo &info)
 void osn::SceneItem::SetVisible(const Napi::CallbackInfo &info, const Napi::Value &value)
 {
 	bool visible = value.ToBoolean().Value();
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && visible == sid->isVisible)
 		return;
@@ -187,7 +187,7 @@ void osn::SceneItem::SetVisible(const Napi::CallbackInfo &info, const Napi::Valu
 
 Napi::Value osn::SceneItem::IsSelected(const Napi::CallbackInfo &info)
 {
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && sid->cached && !sid->selectedChanged) {
 		return Napi::Boolean::New(info.Env(), sid->isSelected);
@@ -212,7 +212,7 @@ Napi::Value osn::SceneItem::IsSelected(const Napi::CallbackInfo &info)
 void osn::SceneItem::SetSelected(const Napi::CallbackInfo &info, const Napi::Value &value)
 {
 	bool selected = value.ToBoolean().Value();
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid == nullptr) {
 		return;
@@ -236,7 +236,7 @@ void osn::SceneItem::SetSelected(const Napi::CallbackInfo &info, const Napi::Val
 
 Napi::Value osn::SceneItem::IsStreamVisible(const Napi::CallbackInfo &info)
 {
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && !sid->streamVisibleChanged)
 		return Napi::Boolean::New(info.Env(), sid->isStreamVisible);
@@ -262,7 +262,7 @@ void osn::SceneItem::SetStreamVisible(const Napi::CallbackInfo &info, const Napi
 {
 	bool streamVisible = value.ToBoolean().Value();
 
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid == nullptr) {
 		return;
@@ -285,7 +285,7 @@ void osn::SceneItem::SetStreamVisible(const Napi::CallbackInfo &info, const Napi
 
 Napi::Value osn::SceneItem::IsRecordingVisible(const Napi::CallbackInfo &info)
 {
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && !sid->recordingVisibleChanged) {
 		return Napi::Boolean::New(info.Env(), sid->isRecordingVisible);
@@ -310,7 +310,7 @@ void osn::SceneItem::SetRecordingVisible(const Napi::CallbackInfo &info, const N
 {
 	bool recordingVisible = value.ToBoolean().Value();
 
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid == nullptr) {
 		return;
@@ -335,7 +335,7 @@ void osn::SceneItem::SetRecordingVisible(const Napi::CallbackInfo &info, const N
 
 Napi::Value osn::SceneItem::GetPosition(const Napi::CallbackInfo &info)
 {
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && !sid->posChanged) {
 		Napi::Object obj = Napi::Object::New(info.Env());
@@ -372,7 +372,7 @@ void osn::SceneItem::SetPosition(const Napi::CallbackInfo &info, const Napi::Val
 	float_t x = vector.Get("x").ToNumber().FloatValue();
 	float_t y = vector.Get("y").ToNumber().FloatValue();
 
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && x == sid->posX && y == sid->posY)
 		return;
@@ -421,7 +421,7 @@ void osn::SceneItem::SetCanvas(const Napi::CallbackInfo &info, const Napi::Value
 
 Napi::Value osn::SceneItem::GetRotation(const Napi::CallbackInfo &info)
 {
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && !sid->rotationChanged)
 		return Napi::Number::New(info.Env(), sid->rotation);
@@ -446,7 +446,7 @@ void osn::SceneItem::SetRotation(const Napi::CallbackInfo &info, const Napi::Val
 {
 	float_t vector = info[0].ToNumber().FloatValue();
 
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && vector == sid->rotation)
 		return;
@@ -462,7 +462,7 @@ void osn::SceneItem::SetRotation(const Napi::CallbackInfo &info, const Napi::Val
 
 Napi::Value osn::SceneItem::GetScale(const Napi::CallbackInfo &info)
 {
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && !sid->scaleChanged) {
 		Napi::Object obj = Napi::Object::New(info.Env());
@@ -499,7 +499,7 @@ void osn::SceneItem::SetScale(const Napi::CallbackInfo &info, const Napi::Value
 	float_t x = vector.Get("x").ToNumber().FloatValue();
 	float_t y = vector.Get("y").ToNumber().FloatValue();
 
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && x == sid->scaleX && y == sid->scaleY)
 		return;
@@ -516,7 +516,7 @@ void osn::SceneItem::SetScale(const Napi::CallbackInfo &info, const Napi::Value
 
 Napi::Value osn::SceneItem::GetScaleFilter(const Napi::CallbackInfo &info)
 {
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && !sid->scaleFilter)
 		return Napi::Number::New(info.Env(), sid->scaleFilter);
@@ -541,7 +541,7 @@ void osn::SceneItem::SetScaleFilter(const Napi::CallbackInfo &info, const Napi::
 {
 	int32_t filter = value.ToNumber().Int32Value();
 
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 	if (sid && sid->scaleFilter == filter)
 		return;
 
@@ -668,7 +668,7 @@ void osn::SceneItem::SetBoundsType(const Napi::CallbackInfo &info, const Napi::V
 
 Napi::Value osn::SceneItem::GetCrop(const Napi::CallbackInfo &info)
 {
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && !sid->cropChanged) {
 		Napi::Object obj = Napi::Object::New(info.Env());
@@ -716,7 +716,7 @@ void osn::SceneItem::SetCrop(const Napi::CallbackInfo &info, const Napi::Value &
 	int32_t right = vector.Get("right").ToNumber().Int32Value();
 	int32_t bottom = vector.Get("bottom").ToNumber().Int32Value();
 
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && left == sid->cropLeft && top == sid->cropTop && right == sid->cropRight && bottom == sid->cropBottom)
 		return;
@@ -805,7 +805,7 @@ void osn::SceneItem::SetTransformInfo(const Napi::CallbackInfo &info, const Napi
 
 Napi::Value osn::SceneItem::GetId(const Napi::CallbackInfo &info)
 {
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid == nullptr) {
 		return info.Env().Undefined();
@@ -901,7 +901,7 @@ Napi::Value osn::SceneItem::DeferUpdateEnd(const Napi::CallbackInfo &info)
 
 Napi::Value osn::SceneItem::GetBlendingMethod(const Napi::CallbackInfo &info)
 {
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && !sid->blendingMethodChanged)
 		return Napi::Number::New(info.Env(), sid->blendingMethod);
@@ -926,7 +926,7 @@ void osn::SceneItem::SetBlendingMethod(const Napi::CallbackInfo &info, const Nap
 {
 	uint32_t method = value.ToNumber().Uint32Value();
 
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 	if (sid && sid->blendingMethod == method)
 		return;
 
@@ -942,7 +942,7 @@ void osn::SceneItem::SetBlendingMethod(const Napi::CallbackInfo &info, const Nap
 
 Napi::Value osn::SceneItem::GetBlendingMode(const Napi::CallbackInfo &info)
 {
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 
 	if (sid && !sid->blendingModeChanged)
 		return Napi::Number::New(info.Env(), sid->blendingMode);
@@ -967,7 +967,7 @@ void osn::SceneItem::SetBlendingMode(const Napi::CallbackInfo &info, const Napi:
 {
 	uint32_t mode = value.ToNumber().Uint32Value();
 
-	SceneItemData *sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
+	std::shared_ptr<SceneItemData> sid = CacheManager<SceneItemData *>::getInstance().Retrieve(this->itemId);
 	if (sid && sid->blendingMode == mode)
 		return;
 
@@ -159,7 +159,7 @@ Napi::Value osn::Service::GetProperties(const Napi::CallbackInfo &info)
 
 	std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(pmap);
 	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
-	auto instance = osn::Properties::constructor.New({prop_ptr, Napi::Number::New(info.Env(), (uint32_t)this->uid)});
+	auto instance = osn::Properties::constructor.New({prop_ptr, Napi::Number::New(info.Env(), this->uid)});
 	return instance;
 }
 
@@ -57,6 +57,8 @@ Napi::Object osn::SimpleRecording::Init(Napi::Env env, Napi::Object exports)
 
 			InstanceMethod("start", &osn::SimpleRecording::Start),
 			InstanceMethod("stop", &osn::SimpleRecording::Stop),
+			InstanceMethod("startAsync", &osn::SimpleRecording::StartAsync),
+			InstanceMethod("stopAsync", &osn::SimpleRecording::StopAsync),
 			InstanceMethod("splitFile", &osn::SimpleRecording::SplitFile),
 
 			StaticAccessor("legacySettings", &osn::SimpleRecording::GetLegacySettings, &osn::SimpleRecording::SetLegacySettings),
@@ -18,6 +18,7 @@
 
 #include "streaming.hpp"
 #include "utility.hpp"
+#include "async-call.hpp"
 #include "video-encoder.hpp"
 #include "service.hpp"
 #include "delay.hpp"
@@ -305,3 +306,26 @@ void osn::Streaming::Stop(const Napi::CallbackInfo &info)
 
 	conn->call(className, "Stop", {ipc::value(this->uid), ipc::value(force)});
 }
+
+static Napi::Value Acknowledge(Napi::Env env, std::vector<ipc::value> &response)
+{
+	ValidateResponse(env, response);
+	return env.Undefined();
+}
+
+// Starting and stopping the same output are kept in order.
+Napi::Value osn::Streaming::StartAsync(const Napi::CallbackInfo &info)
+{
+	startWorker(info.Env(), this->cb.Value(), className, this->uid);
+
+	return async::Call(info.Env(), className, "Start", {ipc::value(this->uid)}, Acknowledge);
+}
+
+Napi::Value osn::Streaming::StopAsync(const Napi::CallbackInfo &info)
+{
+	bool force = false;
+	if (info.Length() == 1)
+		force = info[0].ToBoolean().Value();
+
+	return async::Call(info.Env(), className, "Stop", {ipc::value(this->uid), ipc::value(force)}, Acknowledge);
+}
@@ -24,7 +24,7 @@ namespace osn {
 class Streaming : public WorkerSignals {
 public:
 	uint64_t uid;
-	Streaming() : WorkerSignals(){};
+	Streaming() : WorkerSignals("streaming"){};
 
 protected:
 	Napi::Function signalHandler;
@@ -51,5 +51,7 @@ protected:
 
 	void Start(const Napi::CallbackInfo &info);
 	void Stop(const Napi::CallbackInfo &info);
+	Napi::Value StartAsync(const Napi::CallbackInfo &info);
+	Napi::Value StopAsync(const Napi::CallbackInfo &info);
 };
 }
\ No newline at end of file
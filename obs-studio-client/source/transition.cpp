@@ -45,6 +45,7 @@ Napi::Object osn::Transition::Init(Napi::Env env, Napi::Object exports)
 
 						  InstanceAccessor("configurable", &osn::Transition::CallIsConfigurable, nullptr),
 						  InstanceAccessor("properties", &osn::Transition::CallGetProperties, nullptr),
+						  InstanceMethod("getPropertiesAsync", &osn::Transition::CallGetPropertiesAsync),
 						  InstanceAccessor("settings", &osn::Transition::CallGetSettings, nullptr),
 						  InstanceAccessor("slowUncachedSettings", &osn::Transition::CallGetSlowUncachedSettings, nullptr),
 						  InstanceAccessor("type", &osn::Transition::CallGetType, nullptr),
@@ -293,6 +294,11 @@ Napi::Value osn::Transition::CallGetProperties(const Napi::CallbackInfo &info)
 	return osn::ISource::GetProperties(info, this->sourceId);
 }
 
+Napi::Value osn::Transition::CallGetPropertiesAsync(const Napi::CallbackInfo &info)
+{
+	return osn::ISource::GetPropertiesAsync(info, this->sourceId);
+}
+
 Napi::Value osn::Transition::CallGetSettings(const Napi::CallbackInfo &info)
 {
 	return osn::ISource::GetSettings(info, this->sourceId);
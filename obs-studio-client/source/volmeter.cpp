@@ -40,6 +40,8 @@ Napi::Object osn::Volmeter::Init(Napi::Env env, Napi::Object exports)
 						  InstanceMethod("destroy", &osn::Volmeter::Destroy),
 						  InstanceMethod("attach", &osn::Volmeter::Attach),
 						  InstanceMethod("detach", &osn::Volmeter::Detach),
+
+						  InstanceAccessor("id", &osn::Volmeter::GetId, nullptr),
 					  });
 	exports.Set("Volmeter", func);
 	osn::Volmeter::constructor = Napi::Persistent(func);
@@ -98,6 +100,11 @@ Napi::Value osn::Volmeter::Destroy(const Napi::CallbackInfo &info)
 	return info.Env().Undefined();
 }
 
+Napi::Value osn::Volmeter::GetId(const Napi::CallbackInfo &info)
+{
+	return Napi::Number::New(info.Env(), this->m_uid);
+}
+
 Napi::Value osn::Volmeter::Attach(const Napi::CallbackInfo &info)
 {
 	osn::Input *input = Napi::ObjectWrap<osn::Input>::Unwrap(info[0].ToObject());
@@ -18,6 +18,8 @@
 
 #pragma once
 #include <napi.h>
+#include "controller.hpp"
+#include "event-channel.hpp"
 #include "osn-error.hpp"
 #include "utility.hpp"
 
@@ -26,118 +28,104 @@ struct SignalOutput {
 	std::string signal;
 	int code;
 	std::string errorMessage;
-	bool sent;
-	bool tosend;
 };
 
 class WorkerSignals {
 public:
-	WorkerSignals()
+	WorkerSignals(const std::string &outputType)
 	{
+		this->outputType = outputType;
 		isWorkerRunning = false;
-		workerStop = true;
-		sleepIntervalMS = 33;
-		workerThread = nullptr;
 	};
-	~WorkerSignals(){};
+	~WorkerSignals() { stopWorker(); };
 
 protected:
+	std::string outputType;
 	bool isWorkerRunning;
-	bool workerStop;
-	uint32_t sleepIntervalMS;
-	std::thread *workerThread;
 	Napi::ThreadSafeFunction jsThread;
 	Napi::FunctionReference cb;
 
 	void startWorker(napi_env env, Napi::Function asyncCallback, const std::string &name, const uint64_t &refID)
 	{
-		if (!workerStop || isWorkerRunning)
+		if (isWorkerRunning)
 			return;
 
 		isWorkerRunning = true;
-		workerStop = false;
 		jsThread = Napi::ThreadSafeFunction::New(env, asyncCallback, name.c_str(), 0, 1, [](Napi::Env) {});
-		workerThread = new std::thread(&WorkerSignals::worker, this, name, refID);
+
+		// Signals of every output come through the same channel, keep the
+		// ones of this output. Ids are unique per output type on the server.
+		uint64_t uid = refID;
+		EventChannel::GetInstance().Subscribe(osn::EventType::OutputSignal, this,
+						      [this, uid](const std::vector<const EventChannel::Event *> &events) { dispatch(events, uid); });
+
+		// Deliver what was queued on the server while nobody listened.
+		auto conn = Controller::GetInstance().GetConnection();
+		if (!conn)
+			return;
+
+		std::vector<ipc::value> response = conn->call_synchronous_helper(name, "Query", {ipc::value(refID)});
+		if (response.size() < 2 || response[0].type == ipc::type::Null || (ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok)
+			return;
+
+		std::vector<SignalOutput> *signals = new std::vector<SignalOutput>();
+		for (size_t index = 2; index + 4 <= response.size(); index += 4)
+			signals->push_back({response[index].value_str, response[index + 1].value_str, response[index + 2].value_union.i32,
+					    response[index + 3].value_str});
+		send(signals);
 	}
 
-	void worker(const std::string &name, const uint64_t &refID)
+	void dispatch(const std::vector<const EventChannel::Event *> &events, uint64_t uid)
 	{
-		const static int maximum_signals_in_queue = 100;
-		auto callback = [](Napi::Env env, Napi::Function jsCallback, SignalOutput *data) {
-			try {
-				Napi::Object result = Napi::Object::New(env);
-
-				result.Set(Napi::String::New(env, "type"), Napi::String::New(env, data->outputType));
-				result.Set(Napi::String::New(env, "signal"), Napi::String::New(env, data->signal));
-				result.Set(Napi::String::New(env, "code"), Napi::Number::New(env, data->code));
-				result.Set(Napi::String::New(env, "error"), Napi::String::New(env, data->errorMessage));
-
-				jsCallback.Call({result});
-			} catch (...) {
-				data->tosend = true;
-				return;
-			}
-			data->sent = true;
-		};
-		size_t totalSleepMS = 0;
-		std::vector<SignalOutput *> signalsList;
-		while (!workerStop) {
-			auto tp_start = std::chrono::high_resolution_clock::now();
-
-			// Validate Connection
-			auto conn = Controller::GetInstance().GetConnection();
-			if (conn) {
-				std::vector<ipc::value> response = conn->call_synchronous_helper(name, "Query", {ipc::value(refID)});
-				if ((response.size() == 5) && signalsList.size() < maximum_signals_in_queue) {
-					ErrorCode error = (ErrorCode)response[0].value_union.ui64;
-					if (error == ErrorCode::Ok) {
-						SignalOutput *data = new SignalOutput{"", "", 0, ""};
-						data->outputType = response[1].value_str;
-						data->signal = response[2].value_str;
-						data->code = response[3].value_union.i32;
-						data->errorMessage = response[4].value_str;
-						data->sent = false;
-						data->tosend = true;
-						signalsList.push_back(data);
-					}
-				}
+		std::vector<SignalOutput> *signals = new std::vector<SignalOutput>();
+		for (auto event : events) {
+			const std::vector<ipc::value> &values = event->values;
+			if (values.size() < 5 || values[0].value_str != outputType || values[1].value_union.ui64 != uid)
+				continue;
+
+			signals->push_back({values[0].value_str, values[2].value_str, values[3].value_union.i32, values[4].value_str});
+		}
+		send(signals);
+	}
 
-				std::vector<SignalOutput *>::iterator i = signalsList.begin();
-				while (i != signalsList.end()) {
-					if ((*i)->tosend) {
-						(*i)->tosend = false;
-						napi_status status = jsThread.BlockingCall((*i), callback);
-						if (status != napi_ok) {
-							(*i)->tosend = true;
-							break;
-						}
-					}
-					if ((*i)->sent) {
-						i = signalsList.erase(i);
-					} else {
-						i++;
-					}
+	// Hands a whole batch of signals to JS in a single call to the thread
+	// safe function, the callback is still invoked once per signal.
+	void send(std::vector<SignalOutput> *signals)
+	{
+		auto callback = [](Napi::Env env, Napi::Function jsCallback, std::vector<SignalOutput> *data) {
+			for (auto &signal : *data) {
+				try {
+					Napi::Object result = Napi::Object::New(env);
+
+					result.Set(Napi::String::New(env, "type"), Napi::String::New(env, signal.outputType));
+					result.Set(Napi::String::New(env, "signal"), Napi::String::New(env, signal.signal));
+					result.Set(Napi::String::New(env, "code"), Napi::Number::New(env, signal.code));
+					result.Set(Napi::String::New(env, "error"), Napi::String::New(env, signal.errorMessage));
+
+					jsCallback.Call({result});
+				} catch (...) {
 				}
 			}
+			delete data;
+		};
 
-			auto tp_end = std::chrono::high_resolution_clock::now();
-			auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(tp_end - tp_start);
-			totalSleepMS = sleepIntervalMS - dur.count();
-			std::this_thread::sleep_for(std::chrono::milliseconds(totalSleepMS));
+		if (signals->empty()) {
+			delete signals;
+			return;
 		}
 
-		return;
+		napi_status status = jsThread.NonBlockingCall(signals, callback);
+		if (status != napi_ok)
+			delete signals;
 	}
 
 	void stopWorker(void)
 	{
-		if (workerStop || !isWorkerRunning)
+		if (!isWorkerRunning)
 			return;
 
-		workerStop = true;
 		isWorkerRunning = false;
-		if (workerThread->joinable()) {
-			workerThread->join();
-		}
+		EventChannel::GetInstance().Unsubscribe(osn::EventType::OutputSignal, this);
+		jsThread.Release();
 	}
 };
\ No newline at end of file
@@ -22,53 +22,152 @@
 #include <windows.h>
 #endif
 #include "osn-error.hpp"
+#include "osn-event-channel.hpp"
 #include "shared.hpp"
 #include "osn-source.hpp"
 #include "osn-volmeter.hpp"
+#include <unordered_map>
+#include <unordered_set>
 
-std::mutex sources_sizes_mtx;
-std::map<std::string, SourceSizeInfo *> sources;
+struct SourceSizeChange {
+	uint64_t uid;
+	std::string name;
+	uint32_t width;
+	uint32_t height;
+	uint32_t flags;
+};
+
+static std::mutex sources_sizes_mtx;
+static std::unordered_map<uint64_t, SourceSizeInfo> sources;
+// Sources marked by a signal since the last query, while no client listens to
+// size events.
+static std::unordered_set<uint64_t> sources_dirty;
+
+// Reads the size and flags of a source and records them. Returns true, with
+// the change filled in, if they differ from the ones last reported.
+static bool ExamineSource(uint64_t uid, obs_source_t *source, SourceSizeChange &change)
+{
+	change = {uid, "", obs_source_get_width(source), obs_source_get_height(source), obs_source_get_output_flags(source)};
+
+	{
+		std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
+		auto iter = sources.find(uid);
+		if (iter == sources.end())
+			return false;
+
+		SourceSizeInfo &si = iter->second;
+		if (si.width == change.width && si.height == change.height && si.flags == change.flags)
+			return false;
+		si.width = change.width;
+		si.height = change.height;
+		si.flags = change.flags;
+	}
+
+	const char *name = obs_source_get_name(source);
+	change.name = name ? name : "";
+	return true;
+}
+
+static void PushSizeChange(const SourceSizeChange &change)
+{
+	osn::EventChannel::Push(osn::EventType::SourceSize,
+				{ipc::value(change.uid), ipc::value(change.name), ipc::value(change.width), ipc::value(change.height),
+				 ipc::value(change.flags)},
+				"size:" + std::to_string(change.uid));
+}
+
+// Called from the signals of the source, or of the scene item showing it, so
+// the source is alive. Its size is reported right away to a listening client,
+// and at the next query otherwise.
+static void SourceChanged(obs_source_t *source)
+{
+	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+	if (uid == UINT64_MAX)
+		return;
+
+	if (!osn::EventChannel::IsOpen(osn::EventType::SourceSize)) {
+		std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
+		if (sources.find(uid) != sources.end())
+			sources_dirty.insert(uid);
+		return;
+	}
+
+	SourceSizeChange change;
+	if (ExamineSource(uid, source, change))
+		PushSizeChange(change);
+}
+
+static void SourceUpdated(void *data, calldata_t *cd)
+{
+	obs_source_t *source = nullptr;
+	if (calldata_get_ptr(cd, "source", &source))
+		SourceChanged(source);
+}
+
+// libobs signals the transform of a scene item when the size of its source
+// changed, which is how sources resizing on their own are noticed while they
+// are showing.
+static void SceneItemTransformed(void *data, calldata_t *cd)
+{
+	obs_sceneitem_t *item = nullptr;
+	if (calldata_get_ptr(cd, "item", &item) && item)
+		SourceChanged(obs_sceneitem_get_source(item));
+}
+
+// Examines the dirty sources and returns the ones whose size or flags changed
+// since they were last reported.
+static void CollectSizeChanges(std::vector<SourceSizeChange> &changes)
+{
+	// libobs and the source plugins are called without holding the lock,
+	// the references keep the sources alive meanwhile.
+	std::vector<std::pair<uint64_t, obs_source_t *>> examined;
+	{
+		std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
+		if (sources_dirty.empty())
+			return;
+
+		examined.reserve(sources_dirty.size());
+		for (uint64_t uid : sources_dirty) {
+			auto iter = sources.find(uid);
+			if (iter == sources.end())
+				continue;
+			obs_source_t *source = obs_source_get_ref(iter->second.source);
+			if (source)
+				examined.push_back({uid, source});
+		}
+		sources_dirty.clear();
+	}
+
+	for (auto &item : examined) {
+		SourceSizeChange change;
+		if (ExamineSource(item.first, item.second, change))
+			changes.push_back(std::move(change));
+		obs_source_release(item.second);
+	}
+}
 
 void CallbackManager::Register(ipc::server &srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("CallbackManager");
 	cls->register_function(std::make_shared<ipc::function>("GlobalQuery", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, GlobalQuery));
 	srv.register_collection(cls);
+
+	osn::EventChannel::AddOpenHandler(PushSourceSizes);
 }
 
 void CallbackManager::GlobalQuery(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 
-	if (!sources.empty()) {
-		sources_sizes_mtx.lock();
-		uint32_t size = 0;
-
-		for (auto item : sources) {
-			SourceSizeInfo *si = item.second;
-			// See if width or height changed here
-			uint32_t newWidth = obs_source_get_width(si->source);
-			uint32_t newHeight = obs_source_get_height(si->source);
-			uint32_t newFlags = obs_source_get_output_flags(si->source);
-
-			if (si->width != newWidth || si->height != newHeight || si->flags != newFlags) {
-				si->width = newWidth;
-				si->height = newHeight;
-				si->flags = newFlags;
-
-				rval.push_back(ipc::value(obs_source_get_name(si->source)));
-				rval.push_back(ipc::value(si->width));
-				rval.push_back(ipc::value(si->height));
-				rval.push_back(ipc::value(si->flags));
-
-				size++;
-			}
-		}
+	std::vector<SourceSizeChange> changes;
+	CollectSizeChanges(changes);
 
-		rval.insert(rval.begin() + 1, ipc::value(size));
-		sources_sizes_mtx.unlock();
-	} else {
-		rval.insert(rval.begin() + 1, ipc::value((uint32_t)0));
+	rval.push_back(ipc::value(uint32_t(changes.size())));
+	for (auto &change : changes) {
+		rval.push_back(ipc::value(change.name));
+		rval.push_back(ipc::value(change.width));
+		rval.push_back(ipc::value(change.height));
+		rval.push_back(ipc::value(change.flags));
 	}
 
 	uint64_t size_buffer = args[0].value_union.ui64;
@@ -89,34 +188,73 @@ void CallbackManager::GlobalQuery(void *data, const int64_t id, const std::vecto
 	AUTO_DEBUG;
 }
 
+void CallbackManager::PushSourceSizes()
+{
+	if (!osn::EventChannel::IsOpen(osn::EventType::SourceSize))
+		return;
+
+	std::vector<SourceSizeChange> changes;
+	CollectSizeChanges(changes);
+	for (auto &change : changes)
+		PushSizeChange(change);
+}
+
 void CallbackManager::addSource(obs_source_t *source)
 {
+	if (!source)
+		return;
+
+	if (obs_source_get_type(source) == OBS_SOURCE_TYPE_SCENE) {
+		signal_handler_connect(obs_source_get_signal_handler(source), "item_transform", SceneItemTransformed, nullptr);
+		return;
+	}
+
 	uint32_t flags = obs_source_get_output_flags(source);
 	if ((flags & OBS_SOURCE_VIDEO) == 0)
 		return;
 
-	if (!source || obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER || obs_source_get_type(source) == OBS_SOURCE_TYPE_TRANSITION ||
-	    obs_source_get_type(source) == OBS_SOURCE_TYPE_SCENE)
+	if (obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER || obs_source_get_type(source) == OBS_SOURCE_TYPE_TRANSITION)
 		return;
 
-	std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
+	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+	if (uid == UINT64_MAX)
+		return;
 
-	SourceSizeInfo *si = new SourceSizeInfo;
-	si->source = source;
-	si->width = obs_source_get_width(source);
-	si->height = obs_source_get_height(source);
+	{
+		std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
+		sources[uid].source = source;
+	}
+	// Reported the first time it is examined.
+	SourceChanged(source);
 
-	sources.emplace(std::make_pair(std::string(obs_source_get_name(source)), si));
+	// Sources may have been resized while hidden.
+	signal_handler_t *sh = obs_source_get_signal_handler(source);
+	signal_handler_connect(sh, "update", SourceUpdated, nullptr);
+	signal_handler_connect(sh, "show", SourceUpdated, nullptr);
 }
+
 void CallbackManager::removeSource(obs_source_t *source)
 {
-	std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
-
 	if (!source)
 		return;
 
-	const char *name = obs_source_get_name(source);
+	if (obs_source_get_type(source) == OBS_SOURCE_TYPE_SCENE) {
+		signal_handler_disconnect(obs_source_get_signal_handler(source), "item_transform", SceneItemTransformed, nullptr);
+		return;
+	}
+
+	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+	if (uid == UINT64_MAX)
+		return;
 
-	if (name)
-		sources.erase(name);
-}
\ No newline at end of file
+	{
+		std::unique_lock<std::mutex> ulock(sources_sizes_mtx);
+		if (sources.erase(uid) == 0)
+			return;
+		sources_dirty.erase(uid);
+	}
+
+	signal_handler_t *sh = obs_source_get_signal_handler(source);
+	signal_handler_disconnect(sh, "show", SourceUpdated, nullptr);
+	signal_handler_disconnect(sh, "update", SourceUpdated, nullptr);
+}
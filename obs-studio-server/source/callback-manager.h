@@ -48,7 +48,13 @@ public:
 
 	static void Register(ipc::server &);
 	static void GlobalQuery(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void PushSourceSizes();
 
+	// Sizes are only examined when a signal tells they may have changed: the
+	// source was created, updated or shown, or the transform of a scene item
+	// showing it was updated, which libobs does when the source resized.
+	// Changes are pushed right away while the client listens to size events,
+	// and collected at the next query otherwise.
 	static void addSource(obs_source_t *source);
 	static void removeSource(obs_source_t *source);
 };
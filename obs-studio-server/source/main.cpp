@@ -28,6 +28,12 @@
 #include <thread>
 #include <vector>
 #include "osn-error.hpp"
+#include "osn-batch.hpp"
+#include "osn-event-channel.hpp"
+#include "osn-coalescer.hpp"
+#include "osn-profiler.hpp"
+#include "osn-log-writer.hpp"
+#include "osn-log-limiter.hpp"
 #include "nodeobs_api.h"
 #include "nodeobs_autoconfig.h"
 #include "nodeobs_content.h"
@@ -46,6 +52,7 @@
 #include "osn-video.hpp"
 #include "osn-volmeter.hpp"
 #include "callback-manager.h"
+#include "memory-manager.h"
 #include "osn-video-encoder.hpp"
 #include "osn-service.hpp"
 #include "osn-audio.hpp"
@@ -165,6 +172,52 @@ static void Shutdown(void *data, const int64_t id, const std::vector<ipc::value>
 }
 } // namespace System
 
+// Exposes the regular dispatch path so that batched calls go through exactly
+// the same lookup as calls received directly from a client.
+class BatchServer : public ipc::server {
+public:
+	using ipc::server::client_call_function;
+};
+
+namespace Batch {
+static void Call(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	BatchServer *server = reinterpret_cast<BatchServer *>(data);
+
+	std::vector<osn::batch::Call> calls;
+	if (!osn::batch::deserialize_calls(args[0].value_bin, calls)) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Error));
+		rval.push_back(ipc::value("Malformed batch."));
+		return;
+	}
+
+	// Calls are executed in order, a failing call does not abort the batch.
+	// Each one goes through the server hooks like a call received directly.
+	std::vector<osn::batch::Result> results(calls.size());
+	for (size_t idx = 0; idx < calls.size(); idx++) {
+		const osn::batch::Call &call = calls[idx];
+		osn::batch::Result &result = results[idx];
+		osn::Profiler::Nested(call.collection, call.function, call.args, result, [&]() {
+			std::string errormsg;
+			if (server->client_call_function(id, call.collection, call.function, call.args, result, errormsg))
+				return;
+
+			ipc::value error;
+			error.type = ipc::type::Null;
+			error.value_str = errormsg.empty() ? "Function " + call.collection + "::" + call.function + " not found." : errormsg;
+			result.clear();
+			result.push_back(error);
+		});
+	}
+
+	std::vector<char> buffer;
+	osn::batch::serialize_results(results, buffer);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(buffer));
+}
+} // namespace Batch
+
 int main(int argc, char *argv[])
 {
 #ifdef __APPLE__
@@ -222,7 +275,7 @@ int main(int argc, char *argv[])
 	// argv[2] = version from client ; must match the server version
 
 	// Instance
-	ipc::server myServer;
+	BatchServer myServer;
 	bool doShutdown = false;
 	ServerData sd;
 	sd.last_disconnect = sd.last_connect = std::chrono::high_resolution_clock::now();
@@ -237,6 +290,12 @@ int main(int argc, char *argv[])
 		cls->register_function(std::make_shared<ipc::function>("Shutdown", std::vector<ipc::type>{}, System::Shutdown, &doShutdown));
 		myServer.register_collection(cls);
 	};
+	/// Batch
+	{
+		std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Batch");
+		cls->register_function(std::make_shared<ipc::function>("Call", std::vector<ipc::type>{ipc::type::Binary}, Batch::Call, &myServer));
+		myServer.register_collection(cls);
+	};
 
 	/// OBS Studio Node
 	osn::Global::Register(myServer);
@@ -252,6 +311,11 @@ int main(int argc, char *argv[])
 	osn::Video::Register(myServer);
 	osn::Module::Register(myServer);
 	CallbackManager::Register(myServer);
+	osn::EventChannel::Register(myServer);
+	osn::Coalescer::Register(myServer);
+	osn::Profiler::Register(myServer);
+	MemoryManager::Register(myServer);
+	osn::LogLimiter::Register(myServer);
 	OBS_API::Register(myServer);
 	OBS_content::Register(myServer);
 	OBS_service::Register(myServer);
@@ -320,11 +384,15 @@ int main(int argc, char *argv[])
 #endif
 	osn::Source::finalize_global_signals();
 
+	// A pending EventChannel::Wait would hold back the disconnection.
+	osn::EventChannel::Shutdown();
+
 	// First, be sure there are no connected clients
 	myServer.finalize();
 
 	// Then, shutdown OBS
 	OBS_API::destroyOBS_API();
+	osn::LogWriter::Stop();
 #ifdef __APPLE__
 	util::CrashManager::DeleteBriefCrashInfoFile();
 	if (override_std_fd) {
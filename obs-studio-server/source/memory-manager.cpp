@@ -17,50 +17,158 @@
 ******************************************************************************/
 
 #include "memory-manager.h"
+#include <fstream>
+#include <inttypes.h>
+#include <util/platform.h>
 #include "nodeobs_api.h"
+#include "osn-error.hpp"
 
 struct MemoryManager::source_info {
 	bool cached = false;
+	// Set once unregistered, a worker may still hold the source meanwhile.
+	bool removed = false;
 	uint64_t size = 0;
+	// Last time the source was seen showing, used to pick what to evict.
+	uint64_t last_shown = 0;
 	obs_source_t *source = nullptr;
-	std::vector<std::thread> workers;
 	std::mutex mtx;
 	bool have_video = false;
 };
 
+// Sources are evaluated again once their file is playing, and when they are
+// shown or hidden.
+static const char *requeue_signals[] = {"media_started", "show", "hide"};
+
 MemoryManager &MemoryManager::GetInstance()
 {
 	static MemoryManager instance;
 	return instance;
 }
 
-MemoryManager::MemoryManager()
+#if !defined(WIN32) && !defined(__APPLE__)
+static bool readCgroupValue(const std::string &path, uint64_t &value)
 {
-	blog(LOG_INFO, "MemoryManager: constructor called");
+	// Unlimited cgroups read "max" and are ignored.
+	std::ifstream file(path);
+	return bool(file >> value);
+}
+
+// Memory limit and usage of the cgroup of the process, from the unified (v2)
+// hierarchy or the memory controller (v1). The root files are read when the
+// group of the process is not visible, e.g. in a container.
+static bool readCgroupMemory(uint64_t &limit, uint64_t &usage)
+{
+	std::string unified, memory;
+	std::ifstream cgroup("/proc/self/cgroup");
+	std::string line;
+	while (std::getline(cgroup, line)) {
+		// "<id>:<controllers>:<path>", v2 has id 0 and no controllers.
+		const size_t first = line.find(':');
+		const size_t second = first != std::string::npos ? line.find(':', first + 1) : std::string::npos;
+		if (second == std::string::npos)
+			continue;
+
+		const std::string controllers = "," + line.substr(first + 1, second - first - 1) + ",";
+		const std::string path = line.substr(second + 1);
+		if (line.compare(0, first, "0") == 0 && controllers == ",,")
+			unified = path == "/" ? "" : path;
+		else if (controllers.find(",memory,") != std::string::npos)
+			memory = path == "/" ? "" : path;
+	}
+
+	const std::string v2 = "/sys/fs/cgroup", v1 = "/sys/fs/cgroup/memory";
+	return (readCgroupValue(v2 + unified + "/memory.max", limit) && readCgroupValue(v2 + unified + "/memory.current", usage)) ||
+	       (readCgroupValue(v2 + "/memory.max", limit) && readCgroupValue(v2 + "/memory.current", usage)) ||
+	       (readCgroupValue(v1 + memory + "/memory.limit_in_bytes", limit) && readCgroupValue(v1 + memory + "/memory.usage_in_bytes", usage)) ||
+	       (readCgroupValue(v1 + "/memory.limit_in_bytes", limit) && readCgroupValue(v1 + "/memory.usage_in_bytes", usage));
+}
+#endif
+
+// Physical memory and the part of it still available, 0 when unknown.
+static void queryMemory(uint64_t &total, uint64_t &available)
+{
+	total = 0;
+	available = 0;
 #ifdef WIN32
 	MEMORYSTATUSEX statex;
 	statex.dwLength = sizeof(statex);
 
 	if (::GlobalMemoryStatusEx(&statex)) {
-		available_memory = statex.ullTotalPhys;
-		allowed_cached_size = std::min<uint64_t>(LIMIT, available_memory / 2);
-	} else {
-		available_memory = 0;
-		allowed_cached_size = LIMIT;
+		total = statex.ullTotalPhys;
+		available = statex.ullAvailPhys;
 	}
 #elif __APPLE__
-	available_memory = g_util_osx->getTotalPhysicalMemory();
-	allowed_cached_size = std::min((uint64_t)LIMIT, (uint64_t)available_memory / 2);
+	// Only the physical memory is known, the budget does not follow pressure.
+	total = g_util_osx->getTotalPhysicalMemory();
+	available = total;
+#else
+	std::ifstream meminfo("/proc/meminfo");
+	std::string key, unit;
+	uint64_t value = 0;
+	while (meminfo >> key >> value) {
+		std::getline(meminfo, unit);
+		if (key == "MemTotal:")
+			total = value * 1024;
+		else if (key == "MemAvailable:")
+			available = value * 1024;
+	}
+
+	// The limit of the cgroup applies when it is lower, an unlimited group
+	// leaves the physical memory.
+	uint64_t limit = 0, usage = 0;
+	if (readCgroupMemory(limit, usage)) {
+		if (!total || limit < total) {
+			const uint64_t left = limit > usage ? limit - usage : 0;
+			available = total ? std::min(available, left) : left;
+			total = limit;
+		}
+	}
 #endif
 }
 
+MemoryManager::MemoryManager()
+{
+	blog(LOG_INFO, "MemoryManager: constructor called");
+
+	std::unique_lock ulock(mtx);
+	updateBudget();
+	blog(LOG_INFO, "MemoryManager: %" PRIu64 "MB of memory, %" PRIu64 "MB allowed for caching", total_memory / 1000000,
+	     allowed_cached_size / 1000000);
+}
+
 MemoryManager::~MemoryManager()
 {
 	blog(LOG_INFO, "MemoryManager: destructor called");
 
-	for (auto &source : sources) {
-		unregisterSource(source.second->source);
+	stopWorkers();
+
+	std::map<obs_source_t *, std::shared_ptr<source_info>> remaining;
+	{
+		std::unique_lock ulock(mtx);
+		remaining.swap(sources);
+	}
+
+	for (auto &pair : remaining)
+		teardownSource(*pair.second, false);
+}
+
+// 'si' must already be out of 'sources'. A worker evaluating it meanwhile sees
+// it was removed.
+void MemoryManager::teardownSource(source_info &si, bool cacheNewFiles)
+{
+	for (const char *signal : requeue_signals)
+		signal_handler_disconnect(obs_source_get_signal_handler(si.source), signal, MemoryManager::requeueSource, this);
+
+	{
+		std::unique_lock mtx_lock(mtx, std::defer_lock);
+		std::unique_lock si_mtx_lock(si.mtx, std::defer_lock);
+		std::lock(mtx_lock, si_mtx_lock);
+		removeCachedMemory(si, cacheNewFiles);
+		si.removed = true;
 	}
+
+	// Released without the locks, this may destroy the source.
+	obs_source_release(si.source);
 }
 
 // Not thread safe. 'si.mtx' should be locked
@@ -105,7 +213,7 @@ void MemoryManager::calculateRawSize(source_info &si)
 }
 
 // Not thread safe. 'si.mtx' AND 'mtx' should be locked
-bool MemoryManager::shouldCacheSource(source_info &si)
+bool MemoryManager::isCacheCandidate(source_info &si)
 {
 	obs_data_t *settings = obs_source_get_settings(si.source);
 
@@ -114,15 +222,109 @@ bool MemoryManager::shouldCacheSource(source_info &si)
 	const bool enable_caching = OBS_API::getMediaFileCaching();
 	bool showing = obs_source_showing(si.source);
 
-	const bool is_small = obs_data_get_bool(settings, "caching") ? current_cached_size < allowed_cached_size
-								     : current_cached_size + si.size < allowed_cached_size;
-
 	if (!showing && !obs_data_get_bool(settings, "close_when_inactive"))
 		showing = true;
 
 	obs_data_release(settings);
 
-	return looping && local_file && enable_caching && is_small && showing;
+	return looping && local_file && enable_caching && showing;
+}
+
+// Not thread safe. 'si.mtx' AND 'mtx' should be locked
+bool MemoryManager::shouldCacheSource(source_info &si)
+{
+	if (!isCacheCandidate(si))
+		return false;
+
+	obs_data_t *settings = obs_source_get_settings(si.source);
+	const bool is_small = obs_data_get_bool(settings, "caching") ? current_cached_size < allowed_cached_size
+								     : current_cached_size + si.size < allowed_cached_size;
+	obs_data_release(settings);
+
+	return is_small;
+}
+
+// Not thread safe. 'si.mtx' should be locked
+void MemoryManager::markShowing(source_info &si)
+{
+	if (obs_source_showing(si.source))
+		si.last_shown = os_gettime_ns();
+}
+
+// Not thread safe. 'mtx' should be locked
+void MemoryManager::updateBudget()
+{
+	queryMemory(total_memory, available_memory);
+	if (!total_memory) {
+		allowed_cached_size = LIMIT;
+		return;
+	}
+
+	// The cache itself counts as available, and a tenth of the memory is left
+	// for everything else.
+	const uint64_t reserve = total_memory / 10;
+	const uint64_t room = available_memory + current_cached_size;
+	allowed_cached_size = std::min<uint64_t>({LIMIT, total_memory / 2, room > reserve ? room - reserve : 0});
+
+	if (current_cached_size > allowed_cached_size)
+		evictFor(nullptr);
+}
+
+// Not thread safe. 'mtx' and 'si.mtx' should be locked
+// Uncaches the least recently shown sources until 'si' fits in the budget. A
+// showing source only makes room by evicting sources that are not showing,
+// without 'si' sources are evicted until the cache fits in the budget again.
+void MemoryManager::evictFor(source_info *si)
+{
+	const uint64_t needed = si ? si->size : 0;
+	if (current_cached_size + needed <= allowed_cached_size)
+		return;
+	if (si && !obs_source_showing(si->source))
+		return;
+
+	struct candidate {
+		std::shared_ptr<source_info> info;
+		bool showing;
+		uint64_t last_shown;
+	};
+	std::vector<candidate> candidates;
+	uint64_t evictable = 0;
+	for (const auto &data : sources) {
+		if (data.second.get() == si)
+			continue;
+
+		std::unique_lock ulock(data.second->mtx);
+		if (!data.second->cached)
+			continue;
+
+		markShowing(*data.second);
+		const bool showing = obs_source_showing(data.second->source);
+		if (si && showing)
+			continue;
+
+		candidates.push_back({data.second, showing, data.second->last_shown});
+		evictable += data.second->size;
+	}
+
+	// Nothing is evicted if the source would not fit anyway.
+	if (si && current_cached_size - evictable + needed > allowed_cached_size)
+		return;
+
+	std::sort(candidates.begin(), candidates.end(), [](const candidate &a, const candidate &b) {
+		if (a.showing != b.showing)
+			return !a.showing;
+		return a.last_shown < b.last_shown;
+	});
+
+	for (auto &evicted : candidates) {
+		if (current_cached_size + needed <= allowed_cached_size)
+			break;
+
+		std::unique_lock ulock(evicted.info->mtx);
+		blog(LOG_INFO, "MemoryManager: evicting source %s, %" PRIu64 "MB allowed", obs_source_get_name(evicted.info->source),
+		     allowed_cached_size / 1000000);
+		removeCachedMemory(*evicted.info, false);
+	}
 }
 
 void updateSource(obs_source_t *source, bool caching)
@@ -144,21 +346,11 @@ void MemoryManager::addCachedMemory(source_info &si)
 	if (!si.size || si.cached || current_cached_size + si.size > allowed_cached_size)
 		return;
 
-	int32_t retry = MAX_POLLS;
-
-	proc_handler_t *ph = obs_source_get_proc_handler(si.source);
-	bool playing = false;
-	while (retry > 0) {
-		calldata_t cd = {0};
-		proc_handler_call(ph, "get_playing", &cd);
-		playing = calldata_bool(&cd, "playing");
-		if (playing)
-			break;
-
-		retry--;
-		std::this_thread::sleep_for(std::chrono::milliseconds(100));
-	}
-
+	// Not playing yet, the source is evaluated again on "media_started".
+	calldata_t cd = {0};
+	proc_handler_call(obs_source_get_proc_handler(si.source), "get_playing", &cd);
+	bool playing = calldata_bool(&cd, "playing");
+	calldata_free(&cd);
 	if (!playing)
 		return;
 
@@ -170,12 +362,12 @@ void MemoryManager::addCachedMemory(source_info &si)
 }
 
 // Not thread safe. 'mtx' and 'si.mtx' should be locked
-void MemoryManager::removeCachedMemory(source_info &si, bool cacheNewFiles, const std::string &sourceName)
+void MemoryManager::removeCachedMemory(source_info &si, bool cacheNewFiles)
 {
 	if (!si.cached)
 		return;
 
-	blog(LOG_INFO, "removing %dMB, source: %s", si.size / 1000000, sourceName.c_str());
+	blog(LOG_INFO, "removing %dMB, source: %s", si.size / 1000000, obs_source_get_name(si.source));
 	current_cached_size -= si.size;
 	si.cached = false;
 
@@ -184,6 +376,8 @@ void MemoryManager::removeCachedMemory(source_info &si, bool cacheNewFiles, cons
 	if (!cacheNewFiles || current_cached_size >= allowed_cached_size)
 		return;
 
+	// Showing sources are cached first, the most recently shown first.
+	std::vector<std::pair<std::pair<bool, uint64_t>, source_info *>> candidates;
 	for (const auto &data : sources) {
 		if (data.second.get() == &si) {
 			// Do not check self
@@ -191,24 +385,35 @@ void MemoryManager::removeCachedMemory(source_info &si, bool cacheNewFiles, cons
 		}
 
 		std::unique_lock ulock(data.second->mtx);
-		if (shouldCacheSource(*data.second))
-			addCachedMemory(*data.second);
+		if (!data.second->cached)
+			candidates.push_back({{obs_source_showing(data.second->source), data.second->last_shown}, data.second.get()});
+	}
+	std::sort(candidates.begin(), candidates.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+
+	for (auto &candidate : candidates) {
+		std::unique_lock ulock(candidate.second->mtx);
+		if (shouldCacheSource(*candidate.second))
+			addCachedMemory(*candidate.second);
 	}
 }
 
-void MemoryManager::sourceManager(const std::string &sourceName)
+void MemoryManager::sourceManager(obs_source_t *source)
 {
-	auto it = sources.find(sourceName);
-	if (it == sources.end()) {
-		return;
+	std::shared_ptr<source_info> si;
+	{
+		std::unique_lock ulock(mtx);
+		auto it = sources.find(source);
+		if (it == sources.end())
+			return;
+		si = it->second;
 	}
-	source_info &si = *it->second;
 
-	bool need_get_size = false;
 	{
-		std::unique_lock si_mtx_lock(si.mtx);
+		std::unique_lock si_mtx_lock(si->mtx);
+		if (si->removed)
+			return;
 
-		obs_data_t *settings = obs_source_get_settings(si.source);
+		obs_data_t *settings = obs_source_get_settings(si->source);
 		const bool looping = obs_data_get_bool(settings, "looping");
 		const bool local_file = obs_data_get_bool(settings, "is_local_file");
 		obs_data_release(settings);
@@ -217,63 +422,138 @@ void MemoryManager::sourceManager(const std::string &sourceName)
 			return;
 		}
 
-		need_get_size = si.size == 0;
+		// The size is only known once the file is opened, until then the
+		// source is evaluated again on "media_started".
+		if (si->size == 0)
+			calculateRawSize(*si); // This also sets 'si.have_video'
 	}
 
-	if (need_get_size) {
-		uint32_t retry = MAX_POLLS;
-		while (retry > 0) {
-			si.mtx.lock();
-
-			auto check_source = sources.find(sourceName);
-			if (check_source == sources.end()) {
-				si.mtx.unlock();
-				break;
-			}
-			calculateRawSize(si); // This also sets 'si.have_video'
-
-			if (si.size || !si.have_video) {
-				si.mtx.unlock();
-				break;
-			}
-			si.mtx.unlock();
-
-			retry--;
-			std::this_thread::sleep_for(std::chrono::milliseconds(500));
-		}
+	{
+		std::unique_lock ulock(mtx);
+		updateBudget();
 	}
 
 	std::unique_lock mtx_lock(mtx, std::defer_lock);
-	std::unique_lock si_mtx_lock(si.mtx, std::defer_lock);
+	std::unique_lock si_mtx_lock(si->mtx, std::defer_lock);
 	std::lock(mtx_lock, si_mtx_lock);
 
-	if (!si.size) {
+	if (si->removed || !si->size) {
 		return;
 	}
 
-	const bool should_cache = shouldCacheSource(si);
+	markShowing(*si);
+	if (!si->cached && isCacheCandidate(*si))
+		evictFor(si.get());
+
+	const bool should_cache = shouldCacheSource(*si);
 	if (should_cache)
-		addCachedMemory(si);
+		addCachedMemory(*si);
 	else
-		removeCachedMemory(si, true, sourceName);
+		removeCachedMemory(*si, true);
+}
+
+void MemoryManager::queueEvaluation(obs_source_t *source)
+{
+	std::unique_lock ulock(queue_mtx);
+	if (stopping || !queued.insert(source).second)
+		return;
+
+	queue.push_back(source);
+	if (workers.empty()) {
+		for (size_t idx = 0; idx < MEMORY_MANAGER_WORKERS; idx++)
+			workers.emplace_back(&MemoryManager::worker, this);
+	}
+	queue_cv.notify_one();
+}
+
+void MemoryManager::worker()
+{
+	std::unique_lock ulock(queue_mtx);
+	while (true) {
+		auto iter = queue.end();
+		const bool ready = queue_cv.wait_for(ulock, std::chrono::seconds(MEMORY_MANAGER_BUDGET_INTERVAL), [this, &iter]() {
+			iter = std::find_if(queue.begin(), queue.end(), [this](obs_source_t *source) { return running.count(source) == 0; });
+			return stopping || iter != queue.end();
+		});
+		if (stopping)
+			break;
+
+		if (!ready) {
+			// Idle, follow the memory left on the system.
+			ulock.unlock();
+			{
+				std::unique_lock mtx_lock(mtx);
+				const uint64_t now = os_gettime_ns();
+				if (now >= next_budget_update) {
+					next_budget_update = now + MEMORY_MANAGER_BUDGET_INTERVAL * 1000000000ull;
+					for (const auto &data : sources) {
+						std::unique_lock si_mtx_lock(data.second->mtx);
+						markShowing(*data.second);
+					}
+					updateBudget();
+				}
+			}
+			ulock.lock();
+			continue;
+		}
+
+		obs_source_t *source = *iter;
+		queue.erase(iter);
+		queued.erase(source);
+		running.insert(source);
+		ulock.unlock();
+
+		sourceManager(source);
+
+		ulock.lock();
+		running.erase(source);
+		// The same source may have been queued meanwhile.
+		queue_cv.notify_all();
+	}
+}
+
+void MemoryManager::stopWorkers()
+{
+	std::vector<std::thread> stopped;
+	{
+		std::unique_lock ulock(queue_mtx);
+		stopping = true;
+		stopped.swap(workers);
+		queue.clear();
+		queued.clear();
+		queue_cv.notify_all();
+	}
+
+	for (auto &thread : stopped) {
+		if (thread.joinable())
+			thread.join();
+	}
+
+	std::unique_lock ulock(queue_mtx);
+	stopping = false;
+}
+
+void MemoryManager::requeueSource(void *data, calldata_t *cd)
+{
+	obs_source_t *source = nullptr;
+	if (!calldata_get_ptr(cd, "source", &source))
+		return;
+
+	static_cast<MemoryManager *>(data)->queueEvaluation(source);
 }
 
-// Not thread safe, should be called with locked 'mtx'
+// The sources are only evaluated by the workers, this is safe to call from
+// libobs signals.
 void MemoryManager::updateSettings(obs_source_t *source)
 {
-	std::string sourceName = obs_source_get_name(source);
-	auto it = sources.find(sourceName);
-	if (it == sources.end())
+	if (!isSourceValid(source))
 		return;
 
-	std::unique_lock ulock(it->second->mtx);
-	it->second->workers.push_back(std::thread(&MemoryManager::sourceManager, this, sourceName));
+	queueEvaluation(source);
 }
 
 void MemoryManager::updateSourceCache(obs_source_t *source)
 {
-	std::unique_lock ulock(mtx);
-
 	updateSettings(source);
 }
 
@@ -282,7 +562,7 @@ void MemoryManager::updateSourcesCache()
 	std::unique_lock ulock(mtx);
 
 	for (const auto &data : sources)
-		updateSettings(data.second->source);
+		queueEvaluation(data.first);
 }
 
 bool MemoryManager::isSourceValid(obs_source_t *source) const
@@ -307,11 +587,18 @@ void MemoryManager::registerSource(obs_source_t *source)
 	}
 
 	std::unique_lock ulock(mtx);
+	if (sources.count(source))
+		return;
 
-	source_info *si = new source_info;
+	std::shared_ptr<source_info> si = std::make_shared<source_info>();
 	si->source = obs_source_get_ref(source);
-	sources.emplace(obs_source_get_name(source), si);
+	if (!si->source)
+		return;
+	sources.emplace(source, si);
 	updateSource(source, false);
+
+	for (const char *signal : requeue_signals)
+		signal_handler_connect(obs_source_get_signal_handler(source), signal, MemoryManager::requeueSource, this);
 }
 
 void MemoryManager::unregisterSource(obs_source_t *source)
@@ -320,64 +607,67 @@ void MemoryManager::unregisterSource(obs_source_t *source)
 		return;
 	}
 
-	const std::string source_name = obs_source_get_name(source);
-
-	mtx.lock();
-	auto it = sources.find(source_name);
-	if (it == sources.end()) {
-		mtx.unlock();
-		return;
-	}
+	std::shared_ptr<source_info> si;
+	{
+		std::unique_lock ulock(mtx);
+		auto it = sources.find(source);
+		if (it == sources.end())
+			return;
 
-	// Moving pointer to have a valid object when proceeding with further deinit.
-	auto moved_ptr = std::move(it->second);
-	// Removing object from the collection early to be sure that it is unavailable anymore for outer clients
-	// and someone can not spawn a new worker while we are waiting for worker threads to join.
-	// Also this prevents data race if someone called 'unregisterSource' from other thread
-	// while removal is in progress.
-	sources.erase(source_name);
-	mtx.unlock();
-
-	for (auto &worker : moved_ptr->workers) {
-		if (worker.joinable())
-			worker.join();
+		// Removed from the collection early so no new evaluation can find it.
+		si = it->second;
+		sources.erase(it);
 	}
 
-	std::lock(mtx, moved_ptr->mtx);
-	removeCachedMemory(*moved_ptr, true, source_name);
-	obs_source_release(moved_ptr->source);
-	moved_ptr->mtx.unlock();
-	mtx.unlock();
+	teardownSource(*si, true);
 }
 
 void MemoryManager::shutdownAllSources()
 {
-	mtx.lock();
+	stopWorkers();
 
-	std::vector<std::string> sourceKeys;
-	for (const auto &pair : sources) {
-		sourceKeys.push_back(pair.first);
+	std::map<obs_source_t *, std::shared_ptr<source_info>> remaining;
+	{
+		std::unique_lock ulock(mtx);
+		remaining.swap(sources);
 	}
 
-	for (auto &source_key : sourceKeys) {
-		blog(LOG_INFO, "MemoryManager: shutdownAllSources: source %s", source_key.c_str());
-		auto it = sources.find(source_key);
-		if (it == sources.end()) {
-			continue;
-		}
-
-		auto moved_ptr = std::move(it->second);
-		sources.erase(source_key);
+	for (auto &pair : remaining) {
+		blog(LOG_INFO, "MemoryManager: shutdownAllSources: source %s", obs_source_get_name(pair.first));
+		teardownSource(*pair.second, false);
+	}
+}
 
-		for (auto &worker : moved_ptr->workers) {
-			if (worker.joinable())
-				worker.join();
-		}
+void MemoryManager::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("MemoryManager");
+	cls->register_function(std::make_shared<ipc::function>("GetCacheState", std::vector<ipc::type>{}, GetCacheState));
+	srv.register_collection(cls);
+}
 
-		moved_ptr->mtx.lock();
-		removeCachedMemory(*moved_ptr, false, source_key);
-		moved_ptr->mtx.unlock();
+void MemoryManager::GetCacheState(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	MemoryManager &manager = GetInstance();
+	std::unique_lock ulock(manager.mtx);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(manager.current_cached_size));
+	rval.push_back(ipc::value(manager.allowed_cached_size));
+	rval.push_back(ipc::value(manager.total_memory));
+	rval.push_back(ipc::value(manager.available_memory));
+	rval.push_back(ipc::value((uint32_t)manager.sources.size()));
+
+	const uint64_t now = os_gettime_ns();
+	for (const auto &data : manager.sources) {
+		std::unique_lock si_mtx_lock(data.second->mtx);
+		const source_info &si = *data.second;
+		const char *name = obs_source_get_name(si.source);
+		rval.push_back(ipc::value(std::string(name ? name : "")));
+		rval.push_back(ipc::value(si.size));
+		rval.push_back(ipc::value((uint32_t)si.cached));
+		rval.push_back(ipc::value((uint32_t)obs_source_showing(si.source)));
+		// Milliseconds since the source was last showing, UINT64_MAX if never.
+		rval.push_back(ipc::value(si.last_shown ? (now - si.last_shown) / 1000000 : UINT64_MAX));
 	}
-
-	mtx.unlock();
+	AUTO_DEBUG;
 }
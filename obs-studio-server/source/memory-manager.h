@@ -19,9 +19,14 @@
 #pragma once
 #include "obs.h"
 #include "nodeobs_configManager.hpp"
+#include <ipc-server.hpp>
 #include <map>
 #include <mutex>
 #include <algorithm>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <set>
 #include <vector>
 #include <thread>
 #include <shared.hpp>
@@ -32,7 +37,9 @@
 #endif
 
 #define LIMIT 2004800000ul
-#define MAX_POLLS 10
+#define MEMORY_MANAGER_WORKERS 2
+// Seconds between two checks of the system memory while sources are registered.
+#define MEMORY_MANAGER_BUDGET_INTERVAL 5
 
 // Implements 'Singleton' design pattern
 class MemoryManager {
@@ -46,6 +53,9 @@ public:
 	void updateSourceCache(obs_source_t *source);
 	void updateSourcesCache();
 
+	static void Register(ipc::server &);
+	static void GetCacheState(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+
 private:
 	// Types
 	struct source_info;
@@ -64,15 +74,43 @@ private:
 	void updateSettings(obs_source_t *source);
 
 	void calculateRawSize(source_info &si);
+	bool isCacheCandidate(source_info &si);
 	bool shouldCacheSource(source_info &si);
+	void markShowing(source_info &si);
+	void updateBudget();
+	void evictFor(source_info *si);
 	void addCachedMemory(source_info &si);
-	void removeCachedMemory(source_info &si, bool cacheNewFiles, const std::string &sourceName);
-	void sourceManager(const std::string &sourceName);
+	void removeCachedMemory(source_info &si, bool cacheNewFiles);
+	void sourceManager(obs_source_t *source);
+	void teardownSource(source_info &si, bool cacheNewFiles);
+
+	// Cache decisions are made by a fixed pool of workers. A source queued
+	// again before a worker picked it up is evaluated once, and a source is
+	// never evaluated by two workers at the same time.
+	void queueEvaluation(obs_source_t *source);
+	void worker();
+	void stopWorkers();
+	static void requeueSource(void *data, calldata_t *cd);
 
 	// Data
 	std::mutex mtx;
-	std::map<std::string, std::unique_ptr<source_info>> sources;
-	uint64_t available_memory;
-	uint64_t current_cached_size;
-	uint64_t allowed_cached_size;
+	// Keyed by the source rather than its name, which changes when renamed.
+	// The reference held by source_info keeps the key valid while registered.
+	std::map<obs_source_t *, std::shared_ptr<source_info>> sources;
+
+	std::mutex queue_mtx;
+	std::condition_variable queue_cv;
+	std::list<obs_source_t *> queue;
+	std::set<obs_source_t *> queued;
+	std::set<obs_source_t *> running;
+	std::vector<std::thread> workers;
+	bool stopping = false;
+	uint64_t next_budget_update = 0;
+
+	// The budget follows the memory left on the system (or in the cgroup on
+	// Linux), it is refreshed on every evaluation and periodically.
+	uint64_t total_memory = 0;
+	uint64_t available_memory = 0;
+	uint64_t current_cached_size = 0;
+	uint64_t allowed_cached_size = LIMIT;
 };
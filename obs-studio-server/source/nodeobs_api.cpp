@@ -25,6 +25,10 @@
 #include "osn-filter.hpp"
 #include "osn-volmeter.hpp"
 #include "osn-fader.hpp"
+#include "osn-coalescer.hpp"
+#include "osn-profiler.hpp"
+#include "osn-log-writer.hpp"
+#include "osn-log-limiter.hpp"
 #include "nodeobs_autoconfig.h"
 #include "util/lexer.h"
 #include "util-crashmanager.h"
@@ -90,6 +94,7 @@
 #include "osn-error.hpp"
 #include "shared.hpp"
 
+#include <algorithm>
 #include <fstream>
 
 #define BUFFSIZE 512
@@ -108,7 +113,6 @@ enum crashHandlerCommand {
 };
 
 struct NodeOBSLogParam final {
-	std::fstream logStream;
 	bool enableDebugLogs = true;
 };
 
@@ -177,6 +181,8 @@ void OBS_API::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("GetForceGPURendering", std::vector<ipc::type>{}, GetForceGPURendering));
 	cls->register_function(std::make_shared<ipc::function>("SetForceGPURendering", std::vector<ipc::type>{}, SetForceGPURendering));
 	cls->register_function(std::make_shared<ipc::function>("GetForceGPURenderingLegacy", std::vector<ipc::type>{}, GetForceGPURenderingLegacy));
+	cls->register_function(
+		std::make_shared<ipc::function>("GetLogReport", std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt64, ipc::type::UInt32}, GetLogReport));
 
 	srv.register_collection(cls);
 	g_server = &srv;
@@ -438,6 +444,12 @@ static void node_obs_log(int log_level, const char *msg, va_list args, void *par
 	if (param == nullptr)
 		return;
 
+	// Format incoming text, repeated lines are dropped before they are timestamped and queued.
+	std::vector<char> buf = nodeobs_log_formatted_message(msg, args);
+	std::string_view text = (buf.size()) ? std::string_view(buf.data(), buf.size()) : std::string_view("");
+	if (!osn::LogLimiter::Allow(log_level, msg, text))
+		return;
+
 	// Calculate log time.
 	auto timeSinceStart = (std::chrono::high_resolution_clock::now() - tp);
 	auto days = std::chrono::duration_cast<std::chrono::duration<int, std::ratio<86400>>>(timeSinceStart);
@@ -510,13 +522,6 @@ static void node_obs_log(int log_level, const char *msg, va_list args, void *par
 
 	std::string_view time_and_level(timebuf.data(), length);
 
-	// Format incoming text
-	std::vector<char> buf = nodeobs_log_formatted_message(msg, args);
-	std::string_view text = (buf.size()) ? std::string_view(buf.data(), buf.size()) : std::string_view("");
-
-	std::lock_guard<std::mutex> lock(logMutex);
-
-	outdated_driver_error::instance()->catch_error(msg);
 	NodeOBSLogParam *logParam = reinterpret_cast<NodeOBSLogParam *>(param);
 
 	// Split by \n (new-line)
@@ -534,45 +539,10 @@ static void node_obs_log(int log_level, const char *msg, va_list args, void *par
 
 			last_valid_idx = idx + 1;
 
-			// File Log
-			if (log_level != LOG_DEBUG || logParam->enableDebugLogs) {
-				logParam->logStream << newmsg << std::flush;
-			}
-
-			// Internal Log
-			logReport.push(newmsg, log_level);
-
-			// Std Out / Std Err
-			/// Why fwrite and not std::cout and std::cerr?
-			/// Well, it seems that std::cout and std::cerr break if you click in the console window and paste.
-			/// Which is really bad, as nothing gets logged into the console anymore.
-			if (log_level <= LOG_WARNING) {
-				fwrite(newmsg.data(), sizeof(char), newmsg.length(), stderr);
-			}
-			fwrite(newmsg.data(), sizeof(char), newmsg.length(), stdout);
-
-			// Debugger
-#ifdef _WIN32
-			if (IsDebuggerPresent()) {
-				int wNum = MultiByteToWideChar(CP_UTF8, 0, newmsg.c_str(), -1, NULL, 0);
-				if (wNum > 1) {
-					std::wstring wide_buf;
-					std::mutex wide_mutex;
-
-					std::lock_guard<std::mutex> lock(wide_mutex);
-					wide_buf.reserve(wNum + 1);
-					wide_buf.resize(wNum - 1);
-					MultiByteToWideChar(CP_UTF8, 0, newmsg.c_str(), -1, &wide_buf[0], wNum);
-
-					OutputDebugStringW(wide_buf.c_str());
-				}
-			}
-#endif
+			// File, std out / std err, debugger and internal log are written by the log writer
+			osn::LogWriter::Push(std::move(newmsg), log_level, log_level != LOG_DEBUG || logParam->enableDebugLogs);
 		}
 	}
-	if (log_level != LOG_DEBUG || logParam->enableDebugLogs) {
-		logParam->logStream << std::flush;
-	}
 
 #if defined(_WIN32) && defined(OBS_DEBUGBREAK_ON_ERROR)
 	if (log_level <= LOG_ERROR && IsDebuggerPresent())
@@ -580,6 +550,15 @@ static void node_obs_log(int log_level, const char *msg, va_list args, void *par
 #endif
 }
 
+// Called by the log writer, in order, for every line written
+static void node_obs_log_line(const std::string &line, int log_level)
+{
+	std::lock_guard<std::mutex> lock(logMutex);
+
+	outdated_driver_error::instance()->catch_error(std::string(line, 0, line.find_last_not_of('\n') + 1).c_str());
+	logReport.push(line, log_level);
+}
+
 #ifdef WIN32
 uint32_t pid = GetCurrentProcessId();
 #else
@@ -892,14 +871,16 @@ void OBS_API::OBS_API_initAPI(void *data, const int64_t id, const std::vector<ip
 	logParam->enableDebugLogs = checkIfDebugLogsEnabled(appdata);
 
 #if defined(_WIN32) && defined(UNICODE)
-	logParam->logStream = std::fstream(converter.from_bytes(log_path.c_str()).c_str(), std::ios_base::out | std::ios_base::trunc);
+	std::fstream logStream = std::fstream(converter.from_bytes(log_path.c_str()).c_str(), std::ios_base::out | std::ios_base::trunc);
 #else
-	logParam->logStream = std::fstream(log_path, std::ios_base::out | std::ios_base::trunc);
+	std::fstream logStream = std::fstream(log_path, std::ios_base::out | std::ios_base::trunc);
 #endif
-	if (!logParam->logStream.is_open()) {
+	if (!logStream.is_open()) {
 		logParam.reset();
 		util::CrashManager::AddWarning("Error on log file, failed to open: " + log_path);
 		std::cerr << "Failed to open log file" << std::endl;
+	} else {
+		osn::LogWriter::Start(std::move(logStream), node_obs_log_line, osn::LogLimiter::Sweep);
 	}
 	base_set_log_handler(node_obs_log, (logParam) ? logParam.release() : nullptr);
 #ifndef _DEBUG
@@ -920,14 +901,13 @@ void OBS_API::OBS_API_initAPI(void *data, const int64_t id, const std::vector<ip
 	}
 
 #ifdef WIN32
-	// Register the pre and post server callbacks to log the data into the crashmanager
-	g_server->set_pre_callback(
+	// Forward the pre and post server callbacks to log the data into the crashmanager,
+	// the server callbacks themselves belong to the profiler
+	osn::Profiler::SetForwardHooks(
 		[](std::string cname, std::string fname, const std::vector<ipc::value> &args, void *data) {
 			util::CrashManager &crashManager = *static_cast<util::CrashManager *>(data);
 			crashManager.ProcessPreServerCall(cname, fname, args);
 		},
-		&crashManager);
-	g_server->set_post_callback(
 		[](std::string cname, std::string fname, const std::vector<ipc::value> &args, void *data) {
 			util::CrashManager &crashManager = *static_cast<util::CrashManager *>(data);
 			crashManager.ProcessPostServerCall(cname, fname, args);
@@ -1606,6 +1586,8 @@ void OBS_API::destroyOBS_API(void)
 			DisableAudioDucking(false);
 	}
 #endif
+	osn::Coalescer::Stop();
+	osn::Profiler::Stop();
 	OBS_content::OBS_content_shutdownDisplays();
 
 	autoConfig::WaitPendingTests();
@@ -1819,8 +1801,10 @@ void OBS_API::destroyOBS_API(void)
 					return true;
 				};
 				obs_scene_t *scene = obs_scene_from_source(source);
-				if (scene)
+				if (scene) {
+					osn::Scene::DiscardPendingItems(scene);
 					obs_scene_enum_items(scene, cb, nullptr);
+				}
 			}
 		}
 
@@ -2077,19 +2061,92 @@ double OBS_API::getMemoryUsage()
 	return (double)os_get_proc_resident_size() / (1024.0 * 1024.0);
 }
 
-const std::vector<std::string> &OBS_API::getOBSLogErrors()
+void OBS_API::LogReport::push(const std::string &message, int logLevel)
 {
-	return logReport.errors;
+	static const size_t capacities[Count] = {MaximumErrorMessages, MaximumWarningMessages, MaximumGeneralMessages};
+
+	std::unique_lock<std::timed_mutex> lock(mtx);
+
+	Entry entry;
+	entry.sequence = ++sequence;
+	entry.logLevel = logLevel;
+	entry.message = message;
+
+	auto store = [&](Level level) {
+		Ring &ring = rings[level];
+		if (ring.entries.size() < capacities[level])
+			ring.entries.push_back(entry);
+		else
+			ring.entries[ring.next] = entry;
+		ring.next = (ring.next + 1) % capacities[level];
+		ring.total++;
+	};
+
+	store(General);
+	if (logLevel == LOG_ERROR)
+		store(Errors);
+	if (logLevel == LOG_WARNING)
+		store(Warnings);
 }
 
-const std::vector<std::string> &OBS_API::getOBSLogWarnings()
+bool OBS_API::LogReport::query(Level level, uint64_t since, size_t count, std::vector<Entry> &result, uint64_t &total, uint64_t &last)
 {
-	return logReport.warnings;
+	std::unique_lock<std::timed_mutex> lock(mtx, std::chrono::milliseconds(500));
+	if (!lock.owns_lock())
+		return false;
+
+	const Ring &ring = rings[level];
+	total = ring.total;
+	last = sequence;
+
+	// Walks back from the most recent entry.
+	result.clear();
+	const size_t size = ring.entries.size();
+	for (size_t idx = 0; idx < size && result.size() < count; idx++) {
+		const Entry &entry = ring.entries[(ring.next + size - 1 - idx) % size];
+		if (entry.sequence <= since)
+			break;
+		result.push_back(entry);
+	}
+	std::reverse(result.begin(), result.end());
+	return true;
+}
+
+std::vector<std::string> OBS_API::getOBSLog(LogReport::Level level)
+{
+	std::vector<LogReport::Entry> entries;
+	uint64_t total = 0, last = 0;
+	logReport.query(level, 0, SIZE_MAX, entries, total, last);
+
+	std::vector<std::string> messages;
+	messages.reserve(entries.size());
+	for (auto &entry : entries)
+		messages.push_back(std::move(entry.message));
+	return messages;
 }
 
-std::queue<std::string> &OBS_API::getOBSLogGeneral()
+void OBS_API::GetLogReport(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	return logReport.general;
+	if (args[0].value_union.ui32 >= LogReport::Count) {
+		PRETTY_ERROR_RETURN(ErrorCode::OutOfBounds, "Invalid log level.");
+	}
+
+	std::vector<LogReport::Entry> entries;
+	uint64_t total = 0, last = 0;
+	if (!logReport.query(LogReport::Level(args[0].value_union.ui32), args[1].value_union.ui64, args[2].value_union.ui32, entries, total, last)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Log report is busy.");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(total));
+	rval.push_back(ipc::value(last));
+	rval.push_back(ipc::value((uint32_t)entries.size()));
+	for (auto &entry : entries) {
+		rval.push_back(ipc::value(entry.sequence));
+		rval.push_back(ipc::value((int32_t)entry.logLevel));
+		rval.push_back(ipc::value(entry.message));
+	}
+	AUTO_DEBUG;
 }
 
 std::string OBS_API::getCurrentVersion()
@@ -28,7 +28,7 @@
 #include <string.h>
 #include <string>
 #include <vector>
-#include <queue>
+#include <mutex>
 #include "nodeobs_configManager.hpp"
 #include "nodeobs_service.h"
 #include "util-osx.hpp"
@@ -43,28 +43,38 @@ class OBS_API {
 	friend util::CrashManager;
 
 public:
+	// Most recent log lines, kept in a fixed capacity ring per level. Every line
+	// gets a sequence number, and the number of lines of each level keeps
+	// counting once the older ones are overwritten.
 	struct LogReport {
-		static const int MaximumGeneralMessages = 150;
-
-		void push(std::string message, int logLevel)
-		{
-			general.push(message);
-			if (general.size() >= MaximumGeneralMessages) {
-				general.pop();
-			}
-
-			if (logLevel == LOG_ERROR) {
-				errors.push_back(message);
-			}
-
-			if (logLevel == LOG_WARNING) {
-				warnings.push_back(message);
-			}
-		}
-
-		std::vector<std::string> errors;
-		std::vector<std::string> warnings;
-		std::queue<std::string> general;
+		enum Level { Errors = 0, Warnings, General, Count };
+
+		static const size_t MaximumErrorMessages = 500;
+		static const size_t MaximumWarningMessages = 500;
+		static const size_t MaximumGeneralMessages = 150;
+
+		struct Entry {
+			uint64_t sequence = 0;
+			int logLevel = 0;
+			std::string message;
+		};
+
+		struct Ring {
+			std::vector<Entry> entries;
+			size_t next = 0;
+			uint64_t total = 0;
+		};
+
+		void push(const std::string &message, int logLevel);
+
+		// The most recent entries of a level, at most 'count' and only those
+		// newer than 'since', oldest first. Returns false if the report is busy.
+		bool query(Level level, uint64_t since, size_t count, std::vector<Entry> &result, uint64_t &total, uint64_t &last);
+
+		// Lines being logged when crashing hold the lock, so readers do not wait forever.
+		std::timed_mutex mtx;
+		Ring rings[Count];
+		uint64_t sequence = 0;
 	};
 
 	struct OutputStats {
@@ -130,9 +140,8 @@ public:
 	static double getMemoryUsage();
 	static void getCurrentOutputStats(obs_output_t *output, OBS_API::OutputStats &outputStats);
 
-	static const std::vector<std::string> &getOBSLogErrors();
-	static const std::vector<std::string> &getOBSLogWarnings();
-	static std::queue<std::string> &getOBSLogGeneral();
+	static std::vector<std::string> getOBSLog(LogReport::Level level);
+	static void GetLogReport(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 
 	static std::string getCurrentVersion();
 	static std::string getUsername();
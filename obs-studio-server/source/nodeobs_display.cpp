@@ -28,6 +28,8 @@
 
 #define HANDLE_RADIUS 5.0f
 #define HANDLE_DIAMETER 10.0f
+// Number of cached label runs before the unused ones are dropped.
+#define GLYPH_RUN_CACHE_SIZE 64
 
 std::vector<std::pair<std::string, std::pair<uint32_t, uint32_t>>> sourcesSize;
 
@@ -546,6 +548,7 @@ OBS::Display::~Display()
 		std::lock_guard lock(m_displayMtx);
 
 		obs_display_remove_draw_callback(m_display, DisplayCallback, this);
+		ClearOverlay();
 
 		if (m_source) {
 			if (obs_source_get_type(m_source) == OBS_SOURCE_TYPE_SCENE) {
@@ -807,6 +810,8 @@ void OBS::Display::SetCropOutlineColor(uint8_t r, uint8_t g, uint8_t b, uint8_t
 void OBS::Display::SetGuidelineColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
 {
 	PrepareColor(r, g, b, a, &m_guidelineColor, &m_guidelineColorVec4);
+	// The labels are built with the guideline color.
+	m_overlayGeneration++;
 }
 
 void OBS::Display::SetResizeBoxOuterColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a /*= 255u*/)
@@ -824,13 +829,11 @@ void OBS::Display::SetRotationHandleColor(uint8_t r, uint8_t g, uint8_t b, uint8
 	PrepareColor(r, g, b, a, &m_rotationHandleColor, &m_rotationHandleColorVec4);
 }
 
-static void DrawGlyph(GS::VertexBuffer *vb, float_t x, float_t y, float_t scale, float_t depth, char glyph, uint32_t color)
+static bool GetGlyphUV(char glyph, float &uvX, float &uvY, float uvO)
 {
-	float uvX = 0, uvY = 0, uvO = 1.0 / 4.0;
 	switch (glyph) {
 	default:
-		return;
-		break;
+		return false;
 	case '1':
 		uvX = 0;
 		uvY = 0;
@@ -880,42 +883,53 @@ static void DrawGlyph(GS::VertexBuffer *vb, float_t x, float_t y, float_t scale,
 		uvY = uvO * 2;
 		break;
 	}
+	return true;
+}
+
+// Appends the two triangles of a glyph at 'x' of a run starting at the origin.
+static void BuildGlyph(std::vector<vec3> &positions, std::vector<vec4> &uvs, float_t x, float_t scale, char glyph)
+{
+	float uvX = 0, uvY = 0, uvO = 1.0 / 4.0;
+	if (!GetGlyphUV(glyph, uvX, uvY, uvO))
+		return;
+
+	const float corners[6][2] = {{0, 0}, {1, 0}, {0, 1}, {1, 0}, {0, 1}, {1, 1}}; // TL, TR, BL, TR, BL, BR
+	for (auto &corner : corners) {
+		vec3 position;
+		vec3_set(&position, x + scale * corner[0], scale * 2 * corner[1], 0);
+		positions.push_back(position);
+
+		vec4 uv;
+		vec4_set(&uv, uvX + uvO * corner[0], uvY + uvO * corner[1], 0, 0);
+		uvs.push_back(uv);
+	}
+}
 
-	GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
-	size_t bs = vb->Size();
-	vb->Resize(uint32_t(bs + 6));
-
-	// Top Left
-	v = vb->At(uint32_t(bs + 0));
-	vec3_set(v.position, x, y, depth);
-	vec4_set(v.uv[0], uvX, uvY, 0, 0);
-	*v.color = color;
-	// Top Right
-	v = vb->At(uint32_t(bs + 1));
-	vec3_set(v.position, x + scale, y, depth);
-	vec4_set(v.uv[0], uvX + uvO, uvY, 0, 0);
-	*v.color = color;
-	// Bottom Left
-	v = vb->At(uint32_t(bs + 2));
-	vec3_set(v.position, x, y + scale * 2, depth);
-	vec4_set(v.uv[0], uvX, uvY + uvO, 0, 0);
-	*v.color = color;
-
-	// Top Right
-	v = vb->At(uint32_t(bs + 3));
-	vec3_set(v.position, x + scale, y, depth);
-	vec4_set(v.uv[0], uvX + uvO, uvY, 0, 0);
-	*v.color = color;
-	// Bottom Left
-	v = vb->At(uint32_t(bs + 4));
-	vec3_set(v.position, x, y + scale * 2, depth);
-	vec4_set(v.uv[0], uvX, uvY + uvO, 0, 0);
-	*v.color = color;
-	// Bottom Right
-	v = vb->At(uint32_t(bs + 5));
-	vec3_set(v.position, x + scale, y + scale * 2, depth);
-	vec4_set(v.uv[0], uvX + uvO, uvY + uvO, 0, 0);
-	*v.color = color;
+void OBS::Display::DrawGlyphRun(const char *text, float_t x, float_t y, float_t scale, uint32_t color)
+{
+	auto key = std::make_pair(std::string(text), scale);
+	auto run = m_glyphRuns.find(key);
+	if (run == m_glyphRuns.end()) {
+		GlyphRun glyphs;
+		for (size_t p = 0; text[p]; p++)
+			BuildGlyph(glyphs.positions, glyphs.uvs, p * scale, scale, text[p]);
+		run = m_glyphRuns.emplace(std::move(key), std::move(glyphs)).first;
+	}
+	run->second.lastUsed = m_glyphRunFrame;
+
+	const uint32_t bs = m_textVertices->Size();
+	const uint32_t count = uint32_t(run->second.positions.size());
+	m_textVertices->Resize(bs + count);
+
+	vec3 *positions = m_textVertices->GetPositions() + bs;
+	vec4 *uvs = m_textVertices->GetUVLayer(0) + bs;
+	uint32_t *colors = m_textVertices->GetColors() + bs;
+	for (uint32_t idx = 0; idx < count; idx++) {
+		const vec3 &position = run->second.positions[idx];
+		vec3_set(&positions[idx], position.x + x, position.y + y, 0);
+		uvs[idx] = run->second.uvs[idx];
+		colors[idx] = color;
+	}
 }
 
 inline bool CloseFloat(float a, float b, float epsilon = 0.01)
@@ -1147,7 +1161,36 @@ void OBS::Display::DrawOutline(const matrix4 &mtx, const obs_sceneitem_crop &cro
 	gs_matrix_pop();
 }
 
-bool OBS::Display::DrawSelectedSource(obs_scene_t *scene, obs_sceneitem_t *item, void *param)
+// Scene signals after which the selected items have to be collected again.
+static const char *overlay_signals[] = {"item_add",    "item_remove",   "reorder",        "refresh",    "item_visible",
+					"item_select", "item_deselect", "item_transform", "item_locked"};
+
+void OBS::Display::OverlayChanged(void *data, calldata_t *cd)
+{
+	reinterpret_cast<OBS::Display *>(data)->m_overlayGeneration++;
+}
+
+void OBS::Display::ClearOverlay()
+{
+	for (auto &overlay : m_overlayItems)
+		obs_sceneitem_release(overlay.item);
+	m_overlayItems.clear();
+
+	if (!m_overlayScene)
+		return;
+
+	obs_source_t *scene = obs_weak_source_get_source(m_overlayScene);
+	if (scene) {
+		signal_handler_t *sh = obs_source_get_signal_handler(scene);
+		for (const char *signal : overlay_signals)
+			signal_handler_disconnect(sh, signal, OverlayChanged, this);
+		obs_source_release(scene);
+	}
+	obs_weak_source_release(m_overlayScene);
+	m_overlayScene = nullptr;
+}
+
+bool OBS::Display::CollectSelectedItem(obs_scene_t *scene, obs_sceneitem_t *item, void *param)
 {
 	// This is partially code from OBS Studio. See window-basic-preview.cpp in obs-studio for copyright/license.
 	if (obs_sceneitem_locked(item))
@@ -1162,272 +1205,270 @@ bool OBS::Display::DrawSelectedSource(obs_scene_t *scene, obs_sceneitem_t *item,
 	uint32_t flags = obs_source_get_output_flags(itemSource);
 	bool isOnlyAudio = (flags & OBS_SOURCE_VIDEO) == 0;
 
-	obs_source_t *sceneSource = obs_scene_get_source(scene);
-
-	uint32_t sceneWidth = obs_source_get_width(sceneSource);
-	uint32_t sceneHeight = obs_source_get_height(sceneSource);
 	uint32_t itemWidth = obs_source_get_width(itemSource);
 	uint32_t itemHeight = obs_source_get_height(itemSource);
 
 	if (!obs_sceneitem_selected(item) || isOnlyAudio || ((itemWidth <= 0) && (itemHeight <= 0)))
 		return true;
 
-	matrix4 boxTransform;
+	OverlayItem overlay;
 	matrix4 invBoxTransform;
-	obs_sceneitem_get_box_transform(item, &boxTransform);
-	matrix4_inv(&invBoxTransform, &boxTransform);
+	obs_sceneitem_get_box_transform(item, &overlay.boxTransform);
+	matrix4_inv(&invBoxTransform, &overlay.boxTransform);
 
-	{
-		vec3 bounds[] = {
-			{{{0.f, 0.f, 0.f}}},
-			{{{1.f, 0.f, 0.f}}},
-			{{{0.f, 1.f, 0.f}}},
-			{{{1.f, 1.f, 0.f}}},
-		};
-		bool visible = std::all_of(std::begin(bounds), std::end(bounds), [&](const vec3 &b) {
-			vec3 pos;
-			vec3_transform(&pos, &b, &boxTransform);
-			vec3_transform(&pos, &pos, &invBoxTransform);
-			return CloseFloat(pos.x, b.x) && CloseFloat(pos.y, b.y);
-		});
-
-		if (!visible)
-			return true;
-	}
+	vec3 bounds[] = {
+		{{{0.f, 0.f, 0.f}}},
+		{{{1.f, 0.f, 0.f}}},
+		{{{0.f, 1.f, 0.f}}},
+		{{{1.f, 1.f, 0.f}}},
+	};
 
-	vec4 color;
-	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
-	gs_eparam_t *solid_color = gs_effect_get_param_by_name(solid, "color");
+	bool visible = std::all_of(std::begin(bounds), std::end(bounds), [&](const vec3 &b) {
+		vec3 pos;
+		vec3_transform(&pos, &b, &overlay.boxTransform);
+		vec3_transform(&pos, &pos, &invBoxTransform);
+		return CloseFloat(pos.x, b.x) && CloseFloat(pos.y, b.y);
+	});
 
-	float rot = obs_sceneitem_get_rot(item);
-	bool rot45 = (rot == 45.0f || rot == 135.0f || rot == 225.0f || rot == 315.0f);
+	if (!visible)
+		return true;
 
-	// Prepare data for outline
-	matrix4 curTransform;
-	gs_matrix_get(&curTransform);
+	overlay.width = itemWidth;
+	overlay.height = itemHeight;
+	obs_sceneitem_get_box_scale(item, &overlay.boxScale);
+	obs_sceneitem_get_crop(item, &overlay.crop);
+	overlay.rot = obs_sceneitem_get_rot(item);
+	overlay.rot45 = (overlay.rot == 45.0f || overlay.rot == 135.0f || overlay.rot == 225.0f || overlay.rot == 315.0f);
 
-	vec2 boxScale;
-	obs_sceneitem_get_box_scale(item, &boxScale);
+	obs_sceneitem_addref(item);
+	overlay.item = item;
+	dp->m_overlayItems.push_back(overlay);
 
-	boxScale.x *= curTransform.x.x;
-	boxScale.y *= curTransform.y.y;
+	return true;
+}
 
-	obs_sceneitem_crop crop;
-	obs_sceneitem_get_crop(item, &crop);
+void OBS::Display::UpdateOverlay(obs_scene_t *scene)
+{
+	obs_source_t *sceneSource = obs_scene_get_source(scene);
 
-	dp->DrawOutline(boxTransform, crop, boxScale, solid_color);
+	// Follow the signals of the scene the overlay is drawn for.
+	if (!obs_weak_source_references_source(m_overlayScene, sceneSource)) {
+		ClearOverlay();
+		m_overlayScene = obs_source_get_weak_source(sceneSource);
+		signal_handler_t *sh = obs_source_get_signal_handler(sceneSource);
+		for (const char *signal : overlay_signals)
+			signal_handler_connect(sh, signal, OverlayChanged, this);
+		m_overlayGeneration++;
+	}
 
-	if (dp->m_drawGuideLines) {
-		gs_load_vertexbuffer(dp->m_boxLine->Update(false));
-		gs_effect_set_vec4(solid_color, &dp->m_guidelineColorVec4);
-		DrawGuideline(dp, rot45, 0.5, 0, boxTransform);
-		DrawGuideline(dp, rot45, 0.5, 1, boxTransform);
-		DrawGuideline(dp, rot45, 0, 0.5, boxTransform);
-		DrawGuideline(dp, rot45, 1, 0.5, boxTransform);
+	uint32_t sceneWidth = obs_source_get_width(sceneSource);
+	uint32_t sceneHeight = obs_source_get_height(sceneSource);
 
-		// TEXT RENDERING
-		// THIS DESPERATELY NEEDS TO BE REWRITTEN INTO SHADER CODE
-		// DO SO WHENEVER...
-		GS::Vertex v(nullptr, nullptr, nullptr, nullptr, nullptr);
+	bool changed = m_overlayGeneration != m_overlayBuiltGeneration || m_overlayGuideLines != m_drawGuideLines ||
+		       m_overlaySceneWidth != sceneWidth || m_overlaySceneHeight != sceneHeight ||
+		       m_overlayScale.x != m_previewToWorldScale.x || m_overlayScale.y != m_previewToWorldScale.y;
 
-		matrix4 itemMatrix, sceneToView;
-		obs_sceneitem_get_box_transform(item, &itemMatrix);
-		matrix4_identity(&sceneToView);
-		sceneToView.x.x = dp->m_worldToPreviewScale.x;
-		sceneToView.y.y = dp->m_worldToPreviewScale.y;
-
-		// Retrieve actual corner and edge positions.
-		vec3 edge[4], center;
-		{
-			vec3_set(&edge[0], 0, 0.5, 0);
-			vec3_transform(&edge[0], &edge[0], &itemMatrix);
-			vec3_set(&edge[1], 0.5, 0, 0);
-			vec3_transform(&edge[1], &edge[1], &itemMatrix);
-			vec3_set(&edge[2], 1, 0.5, 0);
-			vec3_transform(&edge[2], &edge[2], &itemMatrix);
-			vec3_set(&edge[3], 0.5, 1, 0);
-			vec3_transform(&edge[3], &edge[3], &itemMatrix);
-
-			vec3_set(&center, 0.5, 0.5, 0);
-			vec3_transform(&center, &center, &itemMatrix);
-			;
-		}
+	// The box transform follows the size of the source, which is not signaled.
+	for (size_t idx = 0; !changed && idx < m_overlayItems.size(); idx++) {
+		obs_source_t *itemSource = obs_sceneitem_get_source(m_overlayItems[idx].item);
+		changed = obs_source_get_width(itemSource) != m_overlayItems[idx].width ||
+			  obs_source_get_height(itemSource) != m_overlayItems[idx].height;
+	}
 
-		std::vector<char> buf(8);
-		float_t pt = 8 * dp->m_previewToWorldScale.y;
-		for (size_t n = 0; n < 4; n++) {
-			bool isIn = (edge[n].x >= 0) && (edge[n].x < sceneWidth) && (edge[n].y >= 0) && (edge[n].y < sceneHeight);
+	if (!changed)
+		return;
 
-			if (!isIn)
-				continue;
+	// Read before collecting, a change signaled meanwhile is picked up next frame.
+	m_overlayBuiltGeneration = m_overlayGeneration;
+	m_overlayGuideLines = m_drawGuideLines;
+	m_overlaySceneWidth = sceneWidth;
+	m_overlaySceneHeight = sceneHeight;
+	m_overlayScale = m_previewToWorldScale;
 
-			vec3 alignLeft, alignTop;
+	for (auto &overlay : m_overlayItems)
+		obs_sceneitem_release(overlay.item);
+	m_overlayItems.clear();
+	obs_scene_enum_items(scene, CollectSelectedItem, this);
 
-			if (rot45) {
-				alignLeft = {-1, -0.2, 0};
-				alignTop = {0.2, -1, 0};
-			} else {
-				alignLeft = {-1, 0, 0};
-				alignTop = {0, -1, 0};
-			}
+	m_textVertices->Resize(0);
+	m_glyphRunFrame++;
 
-			vec3 temp;
-			vec3_sub(&temp, &edge[n], &center);
-			vec3_norm(&temp, &temp);
-			float left = vec3_dot(&temp, &alignLeft), top = vec3_dot(&temp, &alignTop);
-			if (left > 0.707f) { // LEFT
-				float_t dist = edge[n].x;
-				if (dist > (pt * 4)) {
-					size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(dp->m_textVertices, (edge[n].x / 2) - offset + (p * pt), edge[n].y - pt * 2, pt, 0, v,
-							  dp->m_guidelineColor);
-					}
-				}
-			} else if (left < -0.707f) { // RIGHT
-				float_t dist = sceneWidth - edge[n].x;
-				if (dist > (pt * 4)) {
-					size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(dp->m_textVertices, edge[n].x + (dist / 2) - offset + (p * pt), edge[n].y - pt * 2, pt, 0, v,
-							  dp->m_guidelineColor);
-					}
-				}
-			} else if (top > 0.707f) { // UP
-				float_t dist = edge[n].y;
-				if (dist > pt) {
-					size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(dp->m_textVertices, edge[n].x + (p * pt) + 15, edge[n].y - (dist / 2) - pt, pt, 0, v,
-							  dp->m_guidelineColor);
-					}
-				}
-			} else if (top < -0.707f) { // DOWN
-				float_t dist = sceneHeight - edge[n].y;
-				if (dist > (pt * 4)) {
-					size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
-					float_t offset = float((pt * len) / 2.0);
-
-					for (size_t p = 0; p < len; p++) {
-						char v = buf.data()[p];
-						DrawGlyph(dp->m_textVertices, edge[n].x + (p * pt) + 15, edge[n].y + (dist / 2) - pt, pt, 0, v,
-							  dp->m_guidelineColor);
-					}
-				}
-			}
+	if (m_drawGuideLines) {
+		for (auto &overlay : m_overlayItems)
+			BuildSelectedLabels(overlay);
+	}
+
+	if (m_textVertices->Size() > 0)
+		m_textVertices->Update();
+
+	// Labels change while items are moved, only the runs of this build are kept.
+	if (m_glyphRuns.size() > GLYPH_RUN_CACHE_SIZE) {
+		for (auto run = m_glyphRuns.begin(); run != m_glyphRuns.end();) {
+			if (run->second.lastUsed != m_glyphRunFrame)
+				run = m_glyphRuns.erase(run);
+			else
+				run++;
 		}
 	}
+}
+
+void OBS::Display::BuildSelectedLabels(const OverlayItem &overlay)
+{
+	// TEXT RENDERING
+	// THIS DESPERATELY NEEDS TO BE REWRITTEN INTO SHADER CODE
+	// DO SO WHENEVER...
+	const matrix4 &itemMatrix = overlay.boxTransform;
 
-	if (dp->m_drawRotationHandle) {
-		gs_effect_set_vec4(solid_color, &dp->m_rotationHandleColorVec4);
-		dp->DrawRotationHandle(rot, boxTransform);
+	// Retrieve actual corner and edge positions.
+	vec3 edge[4], center;
+	{
+		vec3_set(&edge[0], 0, 0.5, 0);
+		vec3_transform(&edge[0], &edge[0], &itemMatrix);
+		vec3_set(&edge[1], 0.5, 0, 0);
+		vec3_transform(&edge[1], &edge[1], &itemMatrix);
+		vec3_set(&edge[2], 1, 0.5, 0);
+		vec3_transform(&edge[2], &edge[2], &itemMatrix);
+		vec3_set(&edge[3], 0.5, 1, 0);
+		vec3_transform(&edge[3], &edge[3], &itemMatrix);
+
+		vec3_set(&center, 0.5, 0.5, 0);
+		vec3_transform(&center, &center, &itemMatrix);
 	}
 
-	gs_load_vertexbuffer(dp->m_boxTris->Update(false));
-	gs_effect_set_vec4(solid_color, &dp->m_resizeInnerColorVec4);
-	DrawSquareAt(dp, 0, 0, boxTransform);
-	DrawSquareAt(dp, 1, 0, boxTransform);
-	DrawSquareAt(dp, 0, 1, boxTransform);
-	DrawSquareAt(dp, 1, 1, boxTransform);
-	DrawSquareAt(dp, 0.5, 0, boxTransform);
-	DrawSquareAt(dp, 0.5, 1, boxTransform);
-	DrawSquareAt(dp, 0, 0.5, boxTransform);
-	DrawSquareAt(dp, 1, 0.5, boxTransform);
-
-	gs_load_vertexbuffer(dp->m_boxLine->Update(false));
-	gs_effect_set_vec4(solid_color, &dp->m_resizeOuterColorVec4);
-	DrawBoxAt(dp, 0, 0, boxTransform);
-	DrawBoxAt(dp, 1, 0, boxTransform);
-	DrawBoxAt(dp, 0, 1, boxTransform);
-	DrawBoxAt(dp, 1, 1, boxTransform);
-	DrawBoxAt(dp, 0.5, 0, boxTransform);
-	DrawBoxAt(dp, 0.5, 1, boxTransform);
-	DrawBoxAt(dp, 0, 0.5, boxTransform);
-	DrawBoxAt(dp, 1, 0.5, boxTransform);
+	uint32_t sceneWidth = m_overlaySceneWidth;
+	uint32_t sceneHeight = m_overlaySceneHeight;
 
-	return true;
-}
+	std::vector<char> buf(8);
+	float_t pt = 8 * m_previewToWorldScale.y;
+	for (size_t n = 0; n < 4; n++) {
+		bool isIn = (edge[n].x >= 0) && (edge[n].x < sceneWidth) && (edge[n].y >= 0) && (edge[n].y < sceneHeight);
 
-bool OBS::Display::DrawSelectedOverflow(obs_scene_t *scene, obs_sceneitem_t *item, void *param)
-{
-	if (obs_sceneitem_locked(item))
-		return true;
+		if (!isIn)
+			continue;
 
-	OBS::Display *dp = reinterpret_cast<OBS::Display *>(param);
+		vec3 alignLeft, alignTop;
 
-	if (dp->m_canvas != obs_sceneitem_get_canvas(item))
-		return true;
+		if (overlay.rot45) {
+			alignLeft = {-1, -0.2, 0};
+			alignTop = {0.2, -1, 0};
+		} else {
+			alignLeft = {-1, 0, 0};
+			alignTop = {0, -1, 0};
+		}
 
-	obs_source_t *itemSource = obs_sceneitem_get_source(item);
-	uint32_t flags = obs_source_get_output_flags(itemSource);
-	bool isOnlyAudio = (flags & OBS_SOURCE_VIDEO) == 0;
+		vec3 temp;
+		vec3_sub(&temp, &edge[n], &center);
+		vec3_norm(&temp, &temp);
+		float left = vec3_dot(&temp, &alignLeft), top = vec3_dot(&temp, &alignTop);
+		if (left > 0.707f) { // LEFT
+			float_t dist = edge[n].x;
+			if (dist > (pt * 4)) {
+				size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
+				float_t offset = float((pt * len) / 2.0);
+
+				DrawGlyphRun(buf.data(), (edge[n].x / 2) - offset, edge[n].y - pt * 2, pt, m_guidelineColor);
+			}
+		} else if (left < -0.707f) { // RIGHT
+			float_t dist = sceneWidth - edge[n].x;
+			if (dist > (pt * 4)) {
+				size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
+				float_t offset = float((pt * len) / 2.0);
 
-	obs_source_t *sceneSource = obs_scene_get_source(scene);
+				DrawGlyphRun(buf.data(), edge[n].x + (dist / 2) - offset, edge[n].y - pt * 2, pt, m_guidelineColor);
+			}
+		} else if (top > 0.707f) { // UP
+			float_t dist = edge[n].y;
+			if (dist > pt) {
+				size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
+				float_t offset = float((pt * len) / 2.0);
 
-	uint32_t sceneWidth = obs_source_get_width(sceneSource);
-	uint32_t sceneHeight = obs_source_get_height(sceneSource);
-	uint32_t itemWidth = obs_source_get_width(itemSource);
-	uint32_t itemHeight = obs_source_get_height(itemSource);
+				DrawGlyphRun(buf.data(), edge[n].x + 15, edge[n].y - (dist / 2) - pt, pt, m_guidelineColor);
+			}
+		} else if (top < -0.707f) { // DOWN
+			float_t dist = sceneHeight - edge[n].y;
+			if (dist > (pt * 4)) {
+				size_t len = (size_t)snprintf(buf.data(), buf.size(), "%ld px", (uint32_t)dist);
+				float_t offset = float((pt * len) / 2.0);
 
-	if (!obs_sceneitem_selected(item) || isOnlyAudio || ((itemWidth <= 0) && (itemHeight <= 0)))
-		return true;
+				DrawGlyphRun(buf.data(), edge[n].x + 15, edge[n].y + (dist / 2) - pt, pt, m_guidelineColor);
+			}
+		}
+	}
+}
 
-	matrix4 boxTransform;
-	matrix4 invBoxTransform;
-	obs_sceneitem_get_box_transform(item, &boxTransform);
-	matrix4_inv(&invBoxTransform, &boxTransform);
+void OBS::Display::DrawSelectedSource(const OverlayItem &overlay, gs_eparam_t *solid_color)
+{
+	matrix4 boxTransform = overlay.boxTransform;
 
-	vec3 bounds[] = {
-		{{{0.f, 0.f, 0.f}}},
-		{{{1.f, 0.f, 0.f}}},
-		{{{0.f, 1.f, 0.f}}},
-		{{{1.f, 1.f, 0.f}}},
-	};
+	// Prepare data for outline
+	matrix4 curTransform;
+	gs_matrix_get(&curTransform);
 
-	bool visible = std::all_of(std::begin(bounds), std::end(bounds), [&](const vec3 &b) {
-		vec3 pos;
-		vec3_transform(&pos, &b, &boxTransform);
-		vec3_transform(&pos, &pos, &invBoxTransform);
-		return CloseFloat(pos.x, b.x) && CloseFloat(pos.y, b.y);
-	});
+	vec2 boxScale = overlay.boxScale;
+	boxScale.x *= curTransform.x.x;
+	boxScale.y *= curTransform.y.y;
 
-	if (!visible)
-		return true;
+	DrawOutline(boxTransform, overlay.crop, boxScale, solid_color);
 
+	if (m_drawGuideLines) {
+		gs_load_vertexbuffer(m_boxLine->Update(false));
+		gs_effect_set_vec4(solid_color, &m_guidelineColorVec4);
+		DrawGuideline(this, overlay.rot45, 0.5, 0, boxTransform);
+		DrawGuideline(this, overlay.rot45, 0.5, 1, boxTransform);
+		DrawGuideline(this, overlay.rot45, 0, 0.5, boxTransform);
+		DrawGuideline(this, overlay.rot45, 1, 0.5, boxTransform);
+	}
+
+	if (m_drawRotationHandle) {
+		gs_effect_set_vec4(solid_color, &m_rotationHandleColorVec4);
+		DrawRotationHandle(overlay.rot, boxTransform);
+	}
+
+	gs_load_vertexbuffer(m_boxTris->Update(false));
+	gs_effect_set_vec4(solid_color, &m_resizeInnerColorVec4);
+	DrawSquareAt(this, 0, 0, boxTransform);
+	DrawSquareAt(this, 1, 0, boxTransform);
+	DrawSquareAt(this, 0, 1, boxTransform);
+	DrawSquareAt(this, 1, 1, boxTransform);
+	DrawSquareAt(this, 0.5, 0, boxTransform);
+	DrawSquareAt(this, 0.5, 1, boxTransform);
+	DrawSquareAt(this, 0, 0.5, boxTransform);
+	DrawSquareAt(this, 1, 0.5, boxTransform);
+
+	gs_load_vertexbuffer(m_boxLine->Update(false));
+	gs_effect_set_vec4(solid_color, &m_resizeOuterColorVec4);
+	DrawBoxAt(this, 0, 0, boxTransform);
+	DrawBoxAt(this, 1, 0, boxTransform);
+	DrawBoxAt(this, 0, 1, boxTransform);
+	DrawBoxAt(this, 1, 1, boxTransform);
+	DrawBoxAt(this, 0.5, 0, boxTransform);
+	DrawBoxAt(this, 0.5, 1, boxTransform);
+	DrawBoxAt(this, 0, 0.5, boxTransform);
+	DrawBoxAt(this, 1, 0.5, boxTransform);
+}
+
+void OBS::Display::DrawSelectedOverflow(const OverlayItem &overlay)
+{
 	gs_effect_t *repeat = obs_get_base_effect(OBS_EFFECT_REPEAT);
 	gs_eparam_t *image = gs_effect_get_param_by_name(repeat, "image");
 	gs_eparam_t *scale = gs_effect_get_param_by_name(repeat, "scale");
 
 	vec2 s;
-	vec2_set(&s, boxTransform.x.x / 96, boxTransform.y.y / 96);
+	vec2_set(&s, overlay.boxTransform.x.x / 96, overlay.boxTransform.y.y / 96);
 
 	gs_effect_set_vec2(scale, &s);
 
-	gs_texture_t *texture = (dp->m_dayTheme) ? dp->m_overflowDayTexture : dp->m_overflowNightTexture;
+	gs_texture_t *texture = (m_dayTheme) ? m_overflowDayTexture : m_overflowNightTexture;
 	gs_effect_set_texture(image, texture);
 
 	gs_matrix_push();
-	gs_matrix_mul(&boxTransform);
-
-	obs_sceneitem_crop crop;
-	obs_sceneitem_get_crop(item, &crop);
+	gs_matrix_mul(&overlay.boxTransform);
 
 	while (gs_effect_loop(repeat, "Draw")) {
 		gs_draw_sprite(texture, 0, 1, 1);
 	}
 
 	gs_matrix_pop();
-
-	return true;
 }
 
 void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
@@ -1468,6 +1509,12 @@ void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 	 * that are actually scenes and our main transition scene */
 	obs_scene_t *scene = (source) ? obs_scene_from_source(source) : nullptr;
 
+	// Collects the selected items again only when something changed since the last frame.
+	if (scene && dp->m_shouldDrawUI)
+		dp->UpdateOverlay(scene);
+	else
+		dp->ClearOverlay();
+
 	gs_viewport_push();
 	gs_projection_push();
 
@@ -1490,7 +1537,8 @@ void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 
 		gs_matrix_push();
 		gs_matrix_scale3f(dp->m_worldToPreviewScale.x, dp->m_worldToPreviewScale.y, 1.0f);
-		obs_scene_enum_items(scene, DrawSelectedOverflow, dp);
+		for (auto &overlay : dp->m_overlayItems)
+			dp->DrawSelectedOverflow(overlay);
 		gs_matrix_pop();
 	}
 
@@ -1549,19 +1597,18 @@ void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 		gs_ortho(tlCorner.x, brCorner.x, tlCorner.y, brCorner.y, -100.0f, 100.0f);
 		gs_reset_viewport();
 
-		dp->m_textVertices->Resize(0);
-
 		gs_technique_begin(solid_tech);
 		gs_technique_begin_pass(solid_tech, 0);
 
-		obs_scene_enum_items(scene, DrawSelectedSource, dp);
+		for (auto &overlay : dp->m_overlayItems)
+			dp->DrawSelectedSource(overlay, solid_color);
 
 		gs_technique_end_pass(solid_tech);
 		gs_technique_end(solid_tech);
 
-		// Text Rendering
+		// Text Rendering, the labels are uploaded when the overlay is rebuilt.
 		if (dp->m_textVertices->Size() > 0) {
-			gs_vertbuffer_t *vb = dp->m_textVertices->Update();
+			gs_vertbuffer_t *vb = dp->m_textVertices->Update(false);
 			while (gs_effect_loop(dp->m_textEffect, "Draw")) {
 				gs_effect_set_texture(gs_effect_get_param_by_name(dp->m_textEffect, "image"), dp->m_textTexture);
 				gs_load_vertexbuffer(vb);
@@ -1569,6 +1616,7 @@ void OBS::Display::DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy)
 				gs_draw(GS_TRIS, 0, (uint32_t)dp->m_textVertices->Size());
 			}
 		}
+
 	}
 
 	obs_source_release(source);
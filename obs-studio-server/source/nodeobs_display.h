@@ -19,7 +19,10 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <map>
 #include <memory>
+#include <string>
 #include <system_error>
 #include <thread>
 #include <vector>
@@ -90,12 +93,19 @@ public:
 
 private:
 	static void DisplayCallback(void *displayPtr, uint32_t cx, uint32_t cy);
-	static bool DrawSelectedSource(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
-	static bool DrawSelectedOverflow(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
+	struct OverlayItem;
+	static bool CollectSelectedItem(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
+	static void OverlayChanged(void *data, calldata_t *cd);
+	void UpdateOverlay(obs_scene_t *scene);
+	void ClearOverlay();
+	void DrawSelectedSource(const OverlayItem &overlay, gs_eparam_t *solid_color);
+	void DrawSelectedOverflow(const OverlayItem &overlay);
+	void BuildSelectedLabels(const OverlayItem &overlay);
 	obs_source_t *GetSourceForUIEffects();
 	void DrawCropOutline(float x1, float y1, float x2, float y2, vec2 scale);
 	void DrawOutline(const matrix4 &mtx, const obs_sceneitem_crop &crop, const vec2 &boxScale, gs_eparam_t *color);
 	void DrawRotationHandle(float rot, matrix4 &mtx);
+	void DrawGlyphRun(const char *text, float_t x, float_t y, float_t scale, uint32_t color);
 	void setSizeCall(int step);
 
 public: // Rendering code needs it.
@@ -131,6 +141,36 @@ private:
 
 	GS::VertexBuffer *m_textVertices;
 
+	// Geometry of the size labels, built once per text and glyph size with
+	// positions relative to the start of the run.
+	struct GlyphRun {
+		std::vector<vec3> positions;
+		std::vector<vec4> uvs;
+		uint64_t lastUsed = 0;
+	};
+	std::map<std::pair<std::string, float_t>, GlyphRun> m_glyphRuns;
+	uint64_t m_glyphRunFrame = 0;
+
+	// Selected items of the UI scene as of the last rebuild of the overlay.
+	// Scene signals bump the generation, the overlay (and its labels) is only
+	// rebuilt when it or something the overlay depends on changed.
+	struct OverlayItem {
+		obs_sceneitem_t *item;
+		uint32_t width, height;
+		matrix4 boxTransform;
+		vec2 boxScale;
+		obs_sceneitem_crop crop;
+		float rot;
+		bool rot45;
+	};
+	std::vector<OverlayItem> m_overlayItems;
+	std::atomic<uint64_t> m_overlayGeneration{1};
+	uint64_t m_overlayBuiltGeneration = 0;
+	obs_weak_source_t *m_overlayScene = nullptr;
+	vec2 m_overlayScale = {};
+	uint32_t m_overlaySceneWidth = 0, m_overlaySceneHeight = 0;
+	bool m_overlayGuideLines = false;
+
 	std::unique_ptr<GS::VertexBuffer> m_leftSolidOutline;
 	std::unique_ptr<GS::VertexBuffer> m_topSolidOutline;
 	std::unique_ptr<GS::VertexBuffer> m_rightSolidOutline;
@@ -23,6 +23,7 @@
 #include <filesystem>
 #endif
 #include "osn-error.hpp"
+#include "osn-event-channel.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 #include <osn-video.hpp>
@@ -77,6 +78,19 @@ std::mutex signalMutex;
 std::queue<SignalInfo> outputSignal;
 std::thread releaseWorker;
 
+static void pushOutputSignal(SignalInfo &signal)
+{
+	if (osn::EventChannel::IsOpen(osn::EventType::ServiceSignal)) {
+		osn::EventChannel::Push(osn::EventType::ServiceSignal,
+					{ipc::value(signal.getOutputType()), ipc::value(signal.getSignal()), ipc::value(signal.getCode()),
+					 ipc::value(signal.getErrorMessage()), ipc::value(static_cast<int32_t>(signal.getIndex()))});
+		return;
+	}
+
+	std::unique_lock<std::mutex> ulock(signalMutex);
+	outputSignal.push(signal);
+}
+
 static constexpr int kSoundtrackArchiveEncoderIdx = 1;
 static constexpr int kSoundtrackArchiveTrackIdx = 5;
 static obs_encoder_t *streamArchiveEncST = nullptr;
@@ -1263,8 +1277,7 @@ bool OBS_service::startStreaming(StreamServiceId serviceId)
 			signal.setCode(OBS_OUTPUT_ERROR);
 		}
 
-		std::unique_lock<std::mutex> ulock(signalMutex);
-		outputSignal.push(signal);
+		pushOutputSignal(signal);
 	}
 	return isStreaming[serviceId];
 }
@@ -1540,8 +1553,7 @@ bool OBS_service::startRecording(void)
 			}
 			signal.setCode(OBS_OUTPUT_ERROR);
 		}
-		std::unique_lock<std::mutex> ulock(signalMutex);
-		outputSignal.push(signal);
+		pushOutputSignal(signal);
 	}
 	return isRecording;
 }
@@ -1712,8 +1724,7 @@ bool OBS_service::startReplayBuffer(void)
 			}
 			signal.setCode(OBS_OUTPUT_ERROR);
 		}
-		std::unique_lock<std::mutex> ulock(signalMutex);
-		outputSignal.push(signal);
+		pushOutputSignal(signal);
 	} else {
 		isReplayBufferActive = true;
 	}
@@ -2579,24 +2590,23 @@ void OBS_service::OBS_service_connectOutputSignals(void *data, const int64_t id,
 
 void OBS_service::Query(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	std::unique_lock<std::mutex> ulock(signalMutex);
-	if (outputSignal.empty()) {
-		ulock.unlock();
-		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-		AUTO_DEBUG;
-		return;
+	std::queue<SignalInfo> signals;
+	{
+		std::unique_lock<std::mutex> ulock(signalMutex);
+		signals.swap(outputSignal);
 	}
 
-	auto frontSignal = outputSignal.front();
-	outputSignal.pop();
-	ulock.unlock();
-
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	rval.push_back(ipc::value(frontSignal.getOutputType()));
-	rval.push_back(ipc::value(frontSignal.getSignal()));
-	rval.push_back(ipc::value(frontSignal.getCode()));
-	rval.push_back(ipc::value(frontSignal.getErrorMessage()));
-	rval.push_back(ipc::value(static_cast<int32_t>(frontSignal.getIndex())));
+	rval.push_back(ipc::value((uint32_t)signals.size()));
+	while (!signals.empty()) {
+		SignalInfo &signal = signals.front();
+		rval.push_back(ipc::value(signal.getOutputType()));
+		rval.push_back(ipc::value(signal.getSignal()));
+		rval.push_back(ipc::value(signal.getCode()));
+		rval.push_back(ipc::value(signal.getErrorMessage()));
+		rval.push_back(ipc::value(static_cast<int32_t>(signal.getIndex())));
+		signals.pop();
+	}
 
 	AUTO_DEBUG;
 }
@@ -2632,8 +2642,7 @@ void OBS_service::JSCallbackOutputSignal(void *data, calldata_t *params)
 		}
 	}
 
-	std::unique_lock<std::mutex> ulock(signalMutex);
-	outputSignal.push(signal);
+	pushOutputSignal(signal);
 }
 
 void OBS_service::connectOutputSignals(StreamServiceId serviceId)
@@ -70,10 +70,12 @@ void osn::IAdvancedRecording::Register(ipc::server &srv)
 
 void osn::IAdvancedRecording::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	uint64_t uid = osn::IAdvancedRecording::Manager::GetInstance().allocate(new AdvancedRecording());
+	AdvancedRecording *recording = new AdvancedRecording();
+	uint64_t uid = osn::IAdvancedRecording::Manager::GetInstance().allocate(recording);
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+	recording->uid = uid;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
@@ -369,6 +371,7 @@ void osn::IAdvancedRecording::GetLegacySettings(void *data, const int64_t id, co
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+	recording->uid = uid;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
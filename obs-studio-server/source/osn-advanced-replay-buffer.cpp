@@ -53,10 +53,12 @@ void osn::IAdvancedReplayBuffer::Register(ipc::server &srv)
 
 void osn::IAdvancedReplayBuffer::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	uint64_t uid = osn::IAdvancedReplayBuffer::Manager::GetInstance().allocate(new AdvancedReplayBuffer());
+	AdvancedReplayBuffer *replayBuffer = new AdvancedReplayBuffer();
+	uint64_t uid = osn::IAdvancedReplayBuffer::Manager::GetInstance().allocate(replayBuffer);
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+	replayBuffer->uid = uid;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
@@ -233,6 +235,7 @@ void osn::IAdvancedReplayBuffer::GetLegacySettings(void *data, const int64_t id,
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+	replayBuffer->uid = uid;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
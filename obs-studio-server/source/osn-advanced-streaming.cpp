@@ -70,10 +70,12 @@ void osn::IAdvancedStreaming::Register(ipc::server &srv)
 
 void osn::IAdvancedStreaming::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	uint64_t uid = osn::IAdvancedStreaming::Manager::GetInstance().allocate(new AdvancedStreaming());
+	AdvancedStreaming *streaming = new AdvancedStreaming();
+	uint64_t uid = osn::IAdvancedStreaming::Manager::GetInstance().allocate(streaming);
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+	streaming->uid = uid;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
@@ -496,6 +498,7 @@ void osn::IAdvancedStreaming::GetLegacySettings(void *data, const int64_t id, co
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+	streaming->uid = uid;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
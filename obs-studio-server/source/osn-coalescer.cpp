@@ -0,0 +1,174 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#include "osn-coalescer.hpp"
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include "obs.h"
+#include "osn-error.hpp"
+#include "shared.hpp"
+#include "utility.hpp"
+
+struct CoalescedSetter {
+	std::string group;
+	ipc::call_handler_t handler;
+};
+
+struct PendingCall {
+	const CoalescedSetter *setter;
+	std::vector<ipc::value> args;
+};
+
+// Setters are referenced by the registered functions, a list keeps their
+// addresses stable.
+static std::list<CoalescedSetter> coalesced_setters;
+
+static std::mutex coalescer_mtx;
+// Held while pending calls are applied, so a flush from the IPC thread does
+// not return while the tick still applies older values.
+static std::mutex coalescer_apply_mtx;
+static bool coalescer_enabled = false;
+static uint64_t coalescer_sequence = 0;
+// Pending calls ordered by their last write, so independent properties are
+// still applied in the order the client wrote them.
+static std::map<uint64_t, PendingCall> coalescer_pending;
+static std::unordered_map<std::string, uint64_t> coalescer_keys;
+
+void osn::Coalescer::Flush()
+{
+	std::unique_lock<std::mutex> apply_lock(coalescer_apply_mtx);
+	std::map<uint64_t, PendingCall> pending;
+	{
+		std::unique_lock<std::mutex> ulock(coalescer_mtx);
+		pending.swap(coalescer_pending);
+		coalescer_keys.clear();
+	}
+
+	std::vector<ipc::value> rval;
+	for (auto &call : pending) {
+		rval.clear();
+		call.second.setter->handler(nullptr, 0, call.second.args, rval);
+	}
+}
+
+void osn::Coalescer::Discard(const std::string &collection, uint64_t id)
+{
+	std::string prefix = collection + "::";
+	// A flush in progress may still apply a call made for `id`.
+	std::unique_lock<std::mutex> apply_lock(coalescer_apply_mtx);
+	std::unique_lock<std::mutex> ulock(coalescer_mtx);
+	for (auto iter = coalescer_pending.begin(); iter != coalescer_pending.end();) {
+		const std::string &group = iter->second.setter->group;
+		if (iter->second.args[0].value_union.ui64 != id || group.compare(0, prefix.size(), prefix) != 0) {
+			++iter;
+			continue;
+		}
+		coalescer_keys.erase(group + ":" + std::to_string(id));
+		iter = coalescer_pending.erase(iter);
+	}
+}
+
+static void CoalescerTick(void *, float)
+{
+	osn::Coalescer::Flush();
+}
+
+static void CoalescedCall(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	const CoalescedSetter *setter = reinterpret_cast<const CoalescedSetter *>(data);
+
+	std::unique_lock<std::mutex> ulock(coalescer_mtx);
+	if (!coalescer_enabled) {
+		ulock.unlock();
+		setter->handler(nullptr, id, args, rval);
+		return;
+	}
+
+	std::string key = setter->group + ":" + std::to_string(args[0].value_union.ui64);
+	auto iter = coalescer_keys.find(key);
+	if (iter != coalescer_keys.end())
+		coalescer_pending.erase(iter->second);
+
+	uint64_t sequence = coalescer_sequence++;
+	coalescer_pending[sequence] = PendingCall{setter, args};
+	coalescer_keys[key] = sequence;
+	ulock.unlock();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Coalescer::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Coalescer");
+	cls->register_function(std::make_shared<ipc::function>("SetEnabled", std::vector<ipc::type>{ipc::type::UInt32}, SetEnabled));
+	cls->register_function(std::make_shared<ipc::function>("IsEnabled", std::vector<ipc::type>{}, IsEnabled));
+	srv.register_collection(cls);
+}
+
+std::shared_ptr<ipc::function> osn::Coalescer::Setter(const std::string &name, const std::vector<ipc::type> &params, ipc::call_handler_t handler,
+						      const std::string &group)
+{
+	coalesced_setters.push_back(CoalescedSetter{group.empty() ? name : group, handler});
+	return std::make_shared<ipc::function>(name, params, CoalescedCall, &coalesced_setters.back());
+}
+
+static void SetCoalescing(bool enabled)
+{
+	{
+		std::unique_lock<std::mutex> ulock(coalescer_mtx);
+		if (coalescer_enabled == enabled)
+			return;
+		coalescer_enabled = enabled;
+	}
+
+	if (enabled) {
+		obs_add_tick_callback(CoalescerTick, nullptr);
+	} else {
+		obs_remove_tick_callback(CoalescerTick, nullptr);
+		osn::Coalescer::Flush();
+	}
+}
+
+void osn::Coalescer::Stop()
+{
+	SetCoalescing(false);
+}
+
+void osn::Coalescer::SetEnabled(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	if (!obs_initialized()) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Coalescing requires an initialized OBS context.");
+	}
+
+	SetCoalescing(args[0].value_union.ui32 != 0);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Coalescer::IsEnabled(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::unique_lock<std::mutex> ulock(coalescer_mtx);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(uint32_t(coalescer_enabled)));
+	AUTO_DEBUG;
+}
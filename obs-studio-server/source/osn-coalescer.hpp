@@ -0,0 +1,58 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#pragma once
+#include <ipc-server.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace osn {
+// Opt-in coalescing of idempotent setters. While enabled, calls to wrapped
+// setters are acknowledged right away and only the last value written to each
+// (object, property) pair is applied, once per video tick. Setters sharing a
+// property, like the fader ones, use the same group so they replace each other.
+// Wrapped setters must take the object id as their first argument and their
+// replies must not be needed by the client. Reads may see the previous value
+// until the next tick, and calls writing the same state another way must
+// Flush first. Pending calls are applied from the graphics thread, so calls
+// freeing an object must Discard its pending calls before libobs frees it.
+class Coalescer {
+public:
+	static void Register(ipc::server &);
+
+	static std::shared_ptr<ipc::function> Setter(const std::string &name, const std::vector<ipc::type> &params, ipc::call_handler_t handler,
+						     const std::string &group = "");
+
+	// Applies every pending call now.
+	static void Flush();
+
+	// Drops the pending calls made for the object `id` to setters whose group
+	// belongs to `collection`, e.g. "SceneItem" for "SceneItem::Position".
+	// Waits for a flush in progress, which runs under the libobs tick locks,
+	// so it must not be called while holding libobs locks.
+	static void Discard(const std::string &collection, uint64_t id);
+
+	// Applies what is pending and stops coalescing, before libobs shuts down.
+	static void Stop();
+
+	static void SetEnabled(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void IsEnabled(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+};
+} // namespace osn
@@ -0,0 +1,159 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-event-channel.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include "obs.h"
+#include "osn-error.hpp"
+#include "shared.hpp"
+
+// Bounds the queue if the client stops reading. Coalesced events are bounded
+// by the number of sources and meters, so this only limits signals.
+static constexpr size_t MAX_QUEUED_EVENTS = 4096;
+// Upper bound of the timeout requested by the client.
+static constexpr uint32_t MAX_WAIT_TIMEOUT_MS = 1000;
+
+struct QueuedEvent {
+	osn::EventType type;
+	std::vector<ipc::value> values;
+};
+
+static std::mutex channel_mtx;
+static std::condition_variable channel_cv;
+static uint32_t channel_mask = 0;
+static uint64_t channel_generation = 0;
+static std::vector<QueuedEvent> channel_events;
+static std::map<std::string, size_t> channel_keys;
+static std::vector<std::function<void()>> channel_open_handlers;
+static bool channel_shutdown = false;
+
+void osn::EventChannel::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("EventChannel");
+	cls->register_function(std::make_shared<ipc::function>("Open", std::vector<ipc::type>{ipc::type::UInt32}, Open));
+	cls->register_function(std::make_shared<ipc::function>("Close", std::vector<ipc::type>{}, Close));
+	cls->register_function(std::make_shared<ipc::function>("Wait", std::vector<ipc::type>{ipc::type::UInt32}, Wait));
+	srv.register_collection(cls);
+}
+
+bool osn::EventChannel::IsOpen(EventType type)
+{
+	std::unique_lock<std::mutex> ulock(channel_mtx);
+	return (channel_mask & EventMask(type)) != 0;
+}
+
+void osn::EventChannel::Push(EventType type, std::vector<ipc::value> &&values, const std::string &key)
+{
+	std::unique_lock<std::mutex> ulock(channel_mtx);
+	if ((channel_mask & EventMask(type)) == 0)
+		return;
+
+	if (!key.empty()) {
+		auto iter = channel_keys.find(key);
+		if (iter != channel_keys.end()) {
+			channel_events[iter->second].values = std::move(values);
+			return;
+		}
+	}
+
+	if (channel_events.size() >= MAX_QUEUED_EVENTS) {
+		blog(LOG_WARNING, "Event channel is full, dropping event of type %u.", uint32_t(type));
+		return;
+	}
+
+	if (!key.empty())
+		channel_keys.emplace(key, channel_events.size());
+	channel_events.push_back({type, std::move(values)});
+	channel_cv.notify_all();
+}
+
+void osn::EventChannel::AddOpenHandler(std::function<void()> handler)
+{
+	std::unique_lock<std::mutex> ulock(channel_mtx);
+	channel_open_handlers.push_back(handler);
+}
+
+void osn::EventChannel::Shutdown()
+{
+	std::unique_lock<std::mutex> ulock(channel_mtx);
+	channel_shutdown = true;
+	channel_generation++;
+	channel_cv.notify_all();
+}
+
+void osn::EventChannel::Open(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::vector<std::function<void()>> handlers;
+	{
+		std::unique_lock<std::mutex> ulock(channel_mtx);
+		channel_mask = args[0].value_union.ui32;
+		handlers = channel_open_handlers;
+	}
+
+	// Handlers push events themselves, they run without the channel lock.
+	for (auto &handler : handlers)
+		handler();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::EventChannel::Close(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	std::unique_lock<std::mutex> ulock(channel_mtx);
+	channel_mask = 0;
+	channel_events.clear();
+	channel_keys.clear();
+	// Wake up a pending Wait so the client can join its thread right away.
+	channel_generation++;
+	channel_cv.notify_all();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::EventChannel::Wait(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	auto timeout = std::chrono::milliseconds(std::min(args[0].value_union.ui32, MAX_WAIT_TIMEOUT_MS));
+
+	// Producers notify the condition when they queue an event, Close and
+	// Shutdown when the call has to return early.
+	std::unique_lock<std::mutex> ulock(channel_mtx);
+	uint64_t generation = channel_generation;
+	channel_cv.wait_for(ulock, timeout,
+			    [&]() { return channel_shutdown || channel_mask == 0 || generation != channel_generation || !channel_events.empty(); });
+
+	std::vector<QueuedEvent> events;
+	events.swap(channel_events);
+	channel_keys.clear();
+	ulock.unlock();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((uint32_t)events.size()));
+	for (auto &event : events) {
+		rval.push_back(ipc::value((uint32_t)event.type));
+		rval.push_back(ipc::value((uint32_t)event.values.size()));
+		for (auto &value : event.values)
+			rval.push_back(std::move(value));
+	}
+	AUTO_DEBUG;
+}
@@ -0,0 +1,55 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <ipc-server.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+#include "osn-events.hpp"
+
+namespace osn {
+// Pushes output signals, source size changes and volmeter frames to the
+// client. The client keeps one call to Wait pending on a dedicated connection
+// and Wait returns as soon as something is queued, so nothing is polled over
+// IPC anymore.
+class EventChannel {
+public:
+	static void Register(ipc::server &);
+
+	// True if the client listens to events of this type. Producers keep
+	// their previous behavior otherwise.
+	static bool IsOpen(EventType type);
+
+	// Queue an event. Events sharing a non-empty key replace each other
+	// until the client picks them up, so only the latest state is sent.
+	static void Push(EventType type, std::vector<ipc::value> &&values, const std::string &key = "");
+
+	// Called when the client opens the channel, to push the state that
+	// changed while nobody listened.
+	static void AddOpenHandler(std::function<void()> handler);
+
+	// Wakes up a pending Wait and makes the next ones return right away, so
+	// that the server can disconnect its clients.
+	static void Shutdown();
+
+	static void Open(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void Close(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void Wait(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+};
+} // namespace osn
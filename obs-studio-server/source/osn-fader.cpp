@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "osn-fader.hpp"
+#include "osn-coalescer.hpp"
 #include "osn-error.hpp"
 #include "obs.h"
 #include "osn-source.hpp"
@@ -35,11 +36,11 @@ void osn::Fader::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("Create", std::vector<ipc::type>{ipc::type::Int32}, Create));
 	cls->register_function(std::make_shared<ipc::function>("Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
 	cls->register_function(std::make_shared<ipc::function>("GetDeziBel", std::vector<ipc::type>{ipc::type::UInt64}, GetDeziBel));
-	cls->register_function(std::make_shared<ipc::function>("SetDeziBel", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeziBel));
+	cls->register_function(osn::Coalescer::Setter("SetDeziBel", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeziBel, "Fader::Volume"));
 	cls->register_function(std::make_shared<ipc::function>("GetDeflection", std::vector<ipc::type>{ipc::type::UInt64}, GetDeflection));
-	cls->register_function(std::make_shared<ipc::function>("SetDeflection", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeflection));
+	cls->register_function(osn::Coalescer::Setter("SetDeflection", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetDeflection, "Fader::Volume"));
 	cls->register_function(std::make_shared<ipc::function>("GetMultiplier", std::vector<ipc::type>{ipc::type::UInt64}, GetMultiplier));
-	cls->register_function(std::make_shared<ipc::function>("SetMultiplier", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetMultiplier));
+	cls->register_function(osn::Coalescer::Setter("SetMultiplier", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetMultiplier, "Fader::Volume"));
 	cls->register_function(std::make_shared<ipc::function>("Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
 	cls->register_function(std::make_shared<ipc::function>("Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
 	srv.register_collection(cls);
@@ -81,6 +82,8 @@ void osn::Fader::Destroy(void *data, const int64_t id, const std::vector<ipc::va
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid Fader Reference.");
 	}
 
+	osn::Coalescer::Discard("Fader", uid);
+
 	obs_fader_destroy(fader);
 	Manager::GetInstance().free(uid);
 
@@ -21,6 +21,7 @@
 #include <ipc-server.hpp>
 #include <memory>
 #include <obs.h>
+#include "osn-coalescer.hpp"
 #include "osn-error.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
@@ -49,9 +50,10 @@ void osn::Input::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("GetWidth", std::vector<ipc::type>{ipc::type::UInt64}, GetWidth));
 	cls->register_function(std::make_shared<ipc::function>("GetHeight", std::vector<ipc::type>{ipc::type::UInt64}, GetHeight));
 	cls->register_function(std::make_shared<ipc::function>("GetVolume", std::vector<ipc::type>{ipc::type::UInt64}, GetVolume));
-	cls->register_function(std::make_shared<ipc::function>("SetVolume", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetVolume));
+	cls->register_function(osn::Coalescer::Setter("SetVolume", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float}, SetVolume, "Input::Volume"));
 	cls->register_function(std::make_shared<ipc::function>("GetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64}, GetSyncOffset));
-	cls->register_function(std::make_shared<ipc::function>("SetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, SetSyncOffset));
+	cls->register_function(
+		osn::Coalescer::Setter("SetSyncOffset", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, SetSyncOffset, "Input::SyncOffset"));
 	cls->register_function(std::make_shared<ipc::function>("GetAudioMixers", std::vector<ipc::type>{ipc::type::UInt64}, GetAudioMixers));
 	cls->register_function(std::make_shared<ipc::function>("SetAudioMixers", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, SetAudioMixers));
 	cls->register_function(std::make_shared<ipc::function>("GetMonitoringType", std::vector<ipc::type>{ipc::type::UInt64}, GetMonitoringType));
@@ -542,7 +544,10 @@ void osn::Input::GetFilters(void *data, const int64_t id, const std::vector<ipc:
 		}
 	};
 
+	// See Source::GetSettings for why the version is read first.
+	uint64_t version = osn::Source::GetVersion(input);
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(version));
 	obs_source_enum_filters(input, enum_cb, &rval);
 	AUTO_DEBUG;
 }
@@ -0,0 +1,194 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#include "osn-log-limiter.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <inttypes.h>
+#include <mutex>
+#include <util/platform.h>
+#include "obs.h"
+#include "osn-error.hpp"
+#include "shared.hpp"
+
+// Must be a power of two.
+#define LOG_LIMITER_SLOTS 1024
+// Longer lines are truncated in the summary of their repeats.
+#define LOG_LIMITER_TEXT_SIZE 256
+#define LOG_LIMITER_DEFAULT_WINDOW_MS 1000
+#define LOG_LIMITER_DEFAULT_BURST 20
+
+namespace {
+// Messages are tracked in a fixed table by the hash of their text, which is
+// all that is compared when a line is logged. Each hash may use two slots, a
+// slot owned by another hash is only taken over once its window is over.
+struct Entry {
+	std::mutex mtx;
+	uint64_t hash = 0;
+	int level = 0;
+	// Only copied once a line is dropped, for its summary.
+	char text[LOG_LIMITER_TEXT_SIZE] = {};
+	uint64_t windowStart = 0;
+	uint32_t count = 0;
+	uint64_t suppressed = 0;
+};
+
+std::array<Entry, LOG_LIMITER_SLOTS> entries;
+std::atomic<uint64_t> windowNs{LOG_LIMITER_DEFAULT_WINDOW_MS * 1000000ull};
+std::atomic<uint32_t> burst{LOG_LIMITER_DEFAULT_BURST};
+// Entries with dropped lines not reported yet, so idle sweeps are free.
+std::atomic<uint32_t> pending{0};
+std::atomic<uint64_t> totalSuppressed{0};
+
+const char summaryFormat[] = "Previous message repeated %" PRIu64 " more times in %" PRIu64 "ms: %s";
+} // namespace
+
+static uint64_t HashText(int level, const std::string_view &text)
+{
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ull ^ uint64_t(level);
+	for (const char chr : text) {
+		hash ^= uint8_t(chr);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+// 'entry' is locked and owned by the line.
+static bool CountLine(Entry &entry, const std::string_view &text, uint64_t now, uint64_t window, uint32_t limit)
+{
+	// A window with dropped lines is only restarted once they are reported.
+	if (!entry.suppressed && now - entry.windowStart >= window) {
+		entry.windowStart = now;
+		entry.count = 0;
+	}
+
+	if (entry.count < limit) {
+		entry.count++;
+		return true;
+	}
+
+	if (!entry.suppressed++) {
+		const size_t length = std::min(text.size(), sizeof(entry.text) - 1);
+		std::memcpy(entry.text, text.data(), length);
+		entry.text[length] = '\0';
+		pending++;
+	}
+	totalSuppressed++;
+	return false;
+}
+
+bool osn::LogLimiter::Allow(int level, const char *format, const std::string_view &text)
+{
+	// Errors are never dropped.
+	if (!format || format == summaryFormat || level <= LOG_ERROR)
+		return true;
+
+	const uint32_t limit = burst.load(std::memory_order_relaxed);
+	if (!limit)
+		return true;
+
+	const uint64_t hash = HashText(level, text);
+	const uint64_t window = windowNs.load(std::memory_order_relaxed);
+	const uint64_t now = os_gettime_ns();
+
+	Entry *slots[] = {&entries[hash & (LOG_LIMITER_SLOTS - 1)], &entries[(hash >> 32) & (LOG_LIMITER_SLOTS - 1)]};
+	for (Entry *entry : slots) {
+		std::unique_lock ulock(entry->mtx);
+		if (entry->hash == hash && entry->level == level && entry->count)
+			return CountLine(*entry, text, now, window, limit);
+	}
+
+	for (Entry *entry : slots) {
+		std::unique_lock ulock(entry->mtx);
+		if (entry->count && (entry->suppressed || now - entry->windowStart < window))
+			continue;
+
+		entry->hash = hash;
+		entry->level = level;
+		entry->windowStart = now;
+		entry->count = 0;
+		return CountLine(*entry, text, now, window, limit);
+	}
+
+	// Both slots are used by other lines within their window, the line is not
+	// limited until one of them is free.
+	return true;
+}
+
+void osn::LogLimiter::Sweep()
+{
+	if (!pending.load(std::memory_order_relaxed))
+		return;
+
+	struct Summary {
+		int level;
+		std::string text;
+		uint64_t repeats;
+		uint64_t elapsedMs;
+	};
+	std::vector<Summary> summaries;
+
+	const uint64_t window = windowNs.load(std::memory_order_relaxed);
+	const uint64_t now = os_gettime_ns();
+	for (auto &entry : entries) {
+		std::unique_lock ulock(entry.mtx);
+		if (!entry.suppressed || now - entry.windowStart < window)
+			continue;
+
+		summaries.push_back({entry.level, std::string(entry.text), entry.suppressed, (now - entry.windowStart) / 1000000});
+		entry.windowStart = now;
+		entry.count = 0;
+		entry.suppressed = 0;
+		pending--;
+	}
+
+	// Logged without holding any entry, these go through the log handler again.
+	for (auto &summary : summaries)
+		blog(summary.level, summaryFormat, summary.repeats, summary.elapsedMs, summary.text.c_str());
+}
+
+void osn::LogLimiter::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("LogLimiter");
+	cls->register_function(std::make_shared<ipc::function>("SetThresholds", std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt32}, SetThresholds));
+	cls->register_function(std::make_shared<ipc::function>("GetThresholds", std::vector<ipc::type>{}, GetThresholds));
+	srv.register_collection(cls);
+}
+
+void osn::LogLimiter::SetThresholds(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	// A burst of 0 disables the limiter.
+	windowNs = std::max<uint64_t>(args[0].value_union.ui32, 1) * 1000000ull;
+	burst = args[1].value_union.ui32;
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::LogLimiter::GetThresholds(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(uint32_t(windowNs.load() / 1000000)));
+	rval.push_back(ipc::value(burst.load()));
+	rval.push_back(ipc::value(totalSuppressed.load()));
+	AUTO_DEBUG;
+}
@@ -0,0 +1,45 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#pragma once
+#include <ipc-server.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace osn {
+// Collapses storms of the same log line. Every (level, formatted text) pair
+// may log 'burst' lines per window, further lines are dropped and reported
+// later as a single line with the number of repeats. Lines sharing a format
+// but not their text are all kept. Lines are told apart by a hash of their
+// text, and a line whose slots are all used by other lines is not limited.
+class LogLimiter {
+public:
+	static void Register(ipc::server &);
+
+	// Returns false when the line must be dropped, 'text' is the message
+	// formatted from 'format'.
+	static bool Allow(int level, const char *format, const std::string_view &text);
+	// Logs the repeats of the windows that are over, called by the log writer.
+	static void Sweep();
+
+	static void SetThresholds(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void GetThresholds(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+};
+} // namespace osn
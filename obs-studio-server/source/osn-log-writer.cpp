@@ -0,0 +1,252 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#include "osn-log-writer.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <inttypes.h>
+#include <mutex>
+#include <thread>
+#include "obs.h"
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// Must be a power of two.
+#define LOG_WRITER_CAPACITY 8192
+#define LOG_WRITER_INTERVAL_MS 50
+
+namespace {
+// Bounded multi-producer ring, every slot carries a sequence number telling
+// whether it is free for the producer at that position or ready for the
+// consumer, so producers only contend on a single compare-exchange.
+struct Slot {
+	std::atomic<size_t> sequence{0};
+	int level = 0;
+	bool toFile = false;
+	std::string line;
+};
+
+std::array<Slot, LOG_WRITER_CAPACITY> ring;
+std::atomic<size_t> enqueuePos{0};
+std::atomic<size_t> dequeuePos{0};
+std::atomic<uint64_t> dropped{0};
+std::atomic<bool> running{false};
+// Pushes that may enqueue, Stop waits for them after clearing 'running'.
+std::atomic<uint32_t> pushing{0};
+
+// Owns the consumer side of the ring and the outputs.
+std::timed_mutex consumerMtx;
+std::fstream logStream;
+osn::LogWriter::line_callback_t lineCallback = nullptr;
+osn::LogWriter::tick_callback_t tickCallback = nullptr;
+std::string fileBuffer, outBuffer, errBuffer;
+
+std::mutex wakeMtx;
+std::condition_variable wakeCv;
+std::thread writer;
+bool stopping = false;
+} // namespace
+
+static bool Enqueue(std::string &line, int level, bool toFile)
+{
+	size_t pos = enqueuePos.load(std::memory_order_relaxed);
+	while (true) {
+		Slot &slot = ring[pos & (LOG_WRITER_CAPACITY - 1)];
+		const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+		const intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+		if (diff == 0) {
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				slot.level = level;
+				slot.toFile = toFile;
+				slot.line = std::move(line);
+				slot.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (diff < 0) {
+			return false;
+		} else {
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+// Not thread safe. 'consumerMtx' should be locked
+static void Append(const std::string &line, int level, bool toFile)
+{
+	if (toFile)
+		fileBuffer += line;
+
+	/// Why fwrite and not std::cout and std::cerr?
+	/// Well, it seems that std::cout and std::cerr break if you click in the console window and paste.
+	/// Which is really bad, as nothing gets logged into the console anymore.
+	if (level <= LOG_WARNING)
+		errBuffer += line;
+	outBuffer += line;
+
+	if (lineCallback)
+		lineCallback(line, level);
+
+#ifdef _WIN32
+	if (IsDebuggerPresent()) {
+		int wNum = MultiByteToWideChar(CP_UTF8, 0, line.c_str(), -1, NULL, 0);
+		if (wNum > 1) {
+			std::wstring wide_buf;
+			wide_buf.resize(wNum - 1);
+			MultiByteToWideChar(CP_UTF8, 0, line.c_str(), -1, &wide_buf[0], wNum);
+
+			OutputDebugStringW(wide_buf.c_str());
+		}
+	}
+#endif
+}
+
+// Not thread safe. 'consumerMtx' should be locked
+static void WriteBuffers()
+{
+	if (fileBuffer.size() && logStream.is_open())
+		logStream << fileBuffer << std::flush;
+	if (errBuffer.size())
+		fwrite(errBuffer.data(), sizeof(char), errBuffer.length(), stderr);
+	if (outBuffer.size())
+		fwrite(outBuffer.data(), sizeof(char), outBuffer.length(), stdout);
+
+	fileBuffer.clear();
+	errBuffer.clear();
+	outBuffer.clear();
+}
+
+// Not thread safe. 'consumerMtx' should be locked
+static void Drain()
+{
+	const uint64_t lost = dropped.exchange(0);
+	if (lost) {
+		std::string notice = "[LogWriter] " + std::to_string(lost) + " log lines were dropped, the log queue was full\n";
+		Append(notice, LOG_WARNING, true);
+	}
+
+	size_t pos = dequeuePos.load(std::memory_order_relaxed);
+	while (true) {
+		Slot &slot = ring[pos & (LOG_WRITER_CAPACITY - 1)];
+		if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+			break;
+
+		Append(slot.line, slot.level, slot.toFile);
+		slot.line.clear();
+		slot.sequence.store(pos + LOG_WRITER_CAPACITY, std::memory_order_release);
+		pos++;
+	}
+	dequeuePos.store(pos, std::memory_order_relaxed);
+
+	WriteBuffers();
+}
+
+static void Run()
+{
+	std::unique_lock ulock(wakeMtx);
+	while (!stopping) {
+		wakeCv.wait_for(ulock, std::chrono::milliseconds(LOG_WRITER_INTERVAL_MS));
+		ulock.unlock();
+		{
+			std::unique_lock consumer(consumerMtx);
+			Drain();
+		}
+		if (tickCallback)
+			tickCallback();
+		ulock.lock();
+	}
+}
+
+void osn::LogWriter::Start(std::fstream &&stream, line_callback_t callback, tick_callback_t tick)
+{
+	std::unique_lock consumer(consumerMtx);
+	Drain();
+	logStream = std::move(stream);
+	lineCallback = callback;
+
+	std::unique_lock ulock(wakeMtx);
+	tickCallback = tick;
+	if (writer.joinable())
+		return;
+
+	if (!enqueuePos && !dequeuePos) {
+		for (size_t idx = 0; idx < ring.size(); idx++)
+			ring[idx].sequence.store(idx, std::memory_order_relaxed);
+	}
+	stopping = false;
+	writer = std::thread(Run);
+	running = true;
+}
+
+void osn::LogWriter::Stop()
+{
+	{
+		std::unique_lock ulock(wakeMtx);
+		if (!writer.joinable())
+			return;
+		stopping = true;
+	}
+	wakeCv.notify_one();
+	writer.join();
+
+	// Later pushes are written synchronously, the ones that already saw the
+	// writer running are waited for so that their lines are drained below.
+	running = false;
+	while (pushing.load())
+		std::this_thread::yield();
+
+	std::unique_lock consumer(consumerMtx);
+	Drain();
+}
+
+void osn::LogWriter::Push(std::string &&line, int level, bool toFile)
+{
+	pushing++;
+	if (level <= LOG_ERROR || !running.load()) {
+		pushing--;
+		// Written after whatever is still queued, to keep the order.
+		std::unique_lock consumer(consumerMtx);
+		Drain();
+		Append(line, level, toFile);
+		WriteBuffers();
+		return;
+	}
+
+	const bool queued = Enqueue(line, level, toFile);
+	if (!queued)
+		dropped++;
+	pushing--;
+	if (!queued)
+		return;
+
+	// The writer wakes up periodically, unless the ring is filling up.
+	if (enqueuePos.load(std::memory_order_relaxed) - dequeuePos.load(std::memory_order_relaxed) >= LOG_WRITER_CAPACITY / 2)
+		wakeCv.notify_one();
+}
+
+void osn::LogWriter::Flush()
+{
+	// The crashing thread may be the writer itself, so this does not wait forever.
+	std::unique_lock consumer(consumerMtx, std::chrono::milliseconds(500));
+	if (consumer.owns_lock())
+		Drain();
+}
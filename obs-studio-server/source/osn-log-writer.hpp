@@ -0,0 +1,45 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#pragma once
+#include <fstream>
+#include <string>
+
+namespace osn {
+// Writes the server log from a background thread. Logging threads only format
+// their lines and push them to a bounded lock-free ring, the writer drains it
+// in batches to the log file, stdout and stderr, and flushes the file after
+// each batch. Errors are written and flushed before returning, and
+// lines pushed while the ring is full are dropped and counted.
+class LogWriter {
+public:
+	// Called on the writer thread for every line, in order.
+	typedef void (*line_callback_t)(const std::string &line, int level);
+	// Called on the writer thread after every batch, outside of the writer lock.
+	typedef void (*tick_callback_t)();
+
+	static void Start(std::fstream &&stream, line_callback_t callback, tick_callback_t tick = nullptr);
+	// Writes what is still queued, later lines are written synchronously.
+	static void Stop();
+
+	static void Push(std::string &&line, int level, bool toFile);
+	// Writes what is queued from the calling thread, used when crashing.
+	static void Flush();
+};
+} // namespace osn
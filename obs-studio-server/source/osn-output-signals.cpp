@@ -18,6 +18,7 @@
 
 #include "osn-output-signals.hpp"
 #include "nodeobs_api.h"
+#include "osn-event-channel.hpp"
 
 void osn::OutputSignals::createOutput(const std::string &type, const std::string &name)
 {
@@ -65,8 +66,34 @@ static void callback(void *data, calldata_t *params)
 
 	const char *error = obs_output_get_last_error(outputClass->output);
 
-	std::unique_lock<std::mutex> ulock(outputClass->signalsMtx);
-	outputClass->signalsReceived.push({signal, (int)calldata_int(params, "code"), error ? std::string(error) : ""});
+	outputClass->pushSignal({signal, (int)calldata_int(params, "code"), error ? std::string(error) : ""});
+}
+
+void osn::OutputSignals::pushSignal(const signalInfo &signal)
+{
+	if (uid != UINT64_MAX && osn::EventChannel::IsOpen(osn::EventType::OutputSignal)) {
+		osn::EventChannel::Push(osn::EventType::OutputSignal, {ipc::value(outputType), ipc::value(uid), ipc::value(signal.signal),
+								       ipc::value(signal.code), ipc::value(signal.errorMessage)});
+		return;
+	}
+
+	std::unique_lock<std::mutex> ulock(signalsMtx);
+	signalsReceived.push(signal);
+}
+
+void osn::OutputSignals::drainSignals(std::vector<ipc::value> &rval)
+{
+	std::unique_lock<std::mutex> ulock(signalsMtx);
+	rval.reserve(rval.size() + 1 + signalsReceived.size() * 4);
+	rval.push_back(ipc::value((uint32_t)signalsReceived.size()));
+	while (!signalsReceived.empty()) {
+		signalInfo &signal = signalsReceived.front();
+		rval.push_back(ipc::value(outputType));
+		rval.push_back(ipc::value(signal.signal));
+		rval.push_back(ipc::value(signal.code));
+		rval.push_back(ipc::value(signal.errorMessage));
+		signalsReceived.pop();
+	}
 }
 
 void osn::OutputSignals::ConnectSignals()
@@ -111,6 +138,5 @@ void osn::OutputSignals::startOutput()
 		code = OBS_OUTPUT_ERROR;
 	}
 
-	std::unique_lock<std::mutex> ulock(signalsMtx);
-	signalsReceived.push({"stop", code, errorMessage});
+	pushSignal({"stop", code, errorMessage});
 }
\ No newline at end of file
@@ -18,6 +18,7 @@
 
 #pragma once
 #include <obs.h>
+#include <ipc-server.hpp>
 #include <mutex>
 #include <queue>
 #include <vector>
@@ -35,6 +36,7 @@ public:
 	{
 		output = nullptr;
 		canvas = nullptr;
+		uid = UINT64_MAX;
 	}
 	virtual ~OutputSignals() {}
 
@@ -44,8 +46,15 @@ public:
 	std::vector<std::string> signals;
 	obs_output_t *output;
 	obs_video_info *canvas;
+	// Identify the output in pushed events, see osn::EventChannel.
+	std::string outputType;
+	uint64_t uid;
 
 	void ConnectSignals();
+	void pushSignal(const signalInfo &signal);
+	// Moves every pending signal into rval as a count followed by
+	// (outputType, signal, code, error) for each of them.
+	void drainSignals(std::vector<ipc::value> &rval);
 
 public:
 	std::condition_variable cvStop;
@@ -0,0 +1,335 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#include "osn-profiler.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <inttypes.h>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "obs.h"
+#include "osn-error.hpp"
+#include "shared.hpp"
+
+// Latencies are kept in log-linear buckets of microseconds, like HDR
+// histograms: exact below 16us, then every power of two is split in 8 buckets
+// so any percentile is within 12.5% of the real value, up to ~19 hours.
+#define PROFILER_SUB_BUCKETS 8
+#define PROFILER_SUB_BUCKET_BITS 3
+#define PROFILER_LINEAR_BUCKETS (PROFILER_SUB_BUCKETS * 2)
+#define PROFILER_MAX_EXPONENT 35
+#define PROFILER_BUCKETS (PROFILER_LINEAR_BUCKETS + (PROFILER_MAX_EXPONENT - 3) * PROFILER_SUB_BUCKETS)
+#define PROFILER_LOG_ENTRIES 20
+
+struct FunctionStatistics {
+	uint64_t calls = 0;
+	uint64_t errors = 0;
+	uint64_t total_us = 0;
+	uint64_t max_us = 0;
+	uint64_t arg_bytes = 0;
+	uint64_t reply_bytes = 0;
+	std::array<uint32_t, PROFILER_BUCKETS> histogram = {};
+};
+
+static std::atomic<bool> profiler_enabled(false);
+static std::mutex profiler_mtx;
+static std::unordered_map<std::string, FunctionStatistics> profiler_functions;
+
+static std::atomic<osn::Profiler::call_hook_t> forward_pre(nullptr);
+static std::atomic<osn::Profiler::call_hook_t> forward_post(nullptr);
+static std::atomic<void *> forward_data(nullptr);
+
+// Calls from one client are handled on a single thread, so the start of the
+// call in flight is kept per thread.
+static thread_local std::chrono::steady_clock::time_point call_start;
+static thread_local uint64_t call_arg_bytes = 0;
+static thread_local bool call_profiled = false;
+
+static std::mutex profiler_log_mtx;
+static std::condition_variable profiler_log_cv;
+static std::thread profiler_log_worker;
+static uint32_t profiler_log_interval = 0;
+
+static size_t BucketIndex(uint64_t us)
+{
+	if (us < PROFILER_LINEAR_BUCKETS)
+		return size_t(us);
+
+	size_t exponent = PROFILER_SUB_BUCKET_BITS + 1;
+	while ((us >> (exponent + 1)) != 0 && exponent < PROFILER_MAX_EXPONENT)
+		exponent++;
+	if ((us >> (exponent + 1)) != 0)
+		return PROFILER_BUCKETS - 1;
+
+	size_t sub = size_t(us >> (exponent - PROFILER_SUB_BUCKET_BITS)) & (PROFILER_SUB_BUCKETS - 1);
+	return PROFILER_LINEAR_BUCKETS + (exponent - PROFILER_SUB_BUCKET_BITS - 1) * PROFILER_SUB_BUCKETS + sub;
+}
+
+static uint64_t BucketUpperBound(size_t index)
+{
+	if (index < PROFILER_LINEAR_BUCKETS)
+		return uint64_t(index);
+
+	size_t exponent = (index - PROFILER_LINEAR_BUCKETS) / PROFILER_SUB_BUCKETS + PROFILER_SUB_BUCKET_BITS + 1;
+	uint64_t sub = (index - PROFILER_LINEAR_BUCKETS) % PROFILER_SUB_BUCKETS;
+	return ((PROFILER_SUB_BUCKETS + sub + 1) << (exponent - PROFILER_SUB_BUCKET_BITS)) - 1;
+}
+
+static uint64_t Percentile(const FunctionStatistics &stats, double percentile)
+{
+	uint64_t target = uint64_t(double(stats.calls) * percentile + 0.5);
+	uint64_t seen = 0;
+	for (size_t idx = 0; idx < stats.histogram.size(); idx++) {
+		seen += stats.histogram[idx];
+		if (seen >= target && seen > 0)
+			return std::min(BucketUpperBound(idx), stats.max_us);
+	}
+	return stats.max_us;
+}
+
+static uint64_t ValuesSize(const std::vector<ipc::value> &values)
+{
+	uint64_t size = 0;
+	for (auto &value : values) {
+		switch (value.type) {
+		case ipc::type::Float:
+		case ipc::type::Int32:
+		case ipc::type::UInt32:
+			size += 4;
+			break;
+		case ipc::type::Double:
+		case ipc::type::Int64:
+		case ipc::type::UInt64:
+			size += 8;
+			break;
+		case ipc::type::String:
+		case ipc::type::Null:
+			size += value.value_str.size();
+			break;
+		case ipc::type::Binary:
+			size += value.value_bin.size();
+			break;
+		}
+	}
+	return size;
+}
+
+static void PreServerCall(std::string cname, std::string fname, const std::vector<ipc::value> &args, void *data)
+{
+	call_profiled = profiler_enabled;
+	if (call_profiled) {
+		call_arg_bytes = ValuesSize(args);
+		call_start = std::chrono::steady_clock::now();
+	}
+
+	osn::Profiler::call_hook_t forward = forward_pre;
+	if (forward)
+		forward(cname, fname, args, forward_data);
+}
+
+static void PostServerCall(std::string cname, std::string fname, const std::vector<ipc::value> &rval, void *data)
+{
+	if (call_profiled) {
+		call_profiled = false;
+		uint64_t us = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - call_start).count());
+		uint64_t reply_bytes = ValuesSize(rval);
+		bool failed = rval.size() == 0 || rval[0].type != ipc::type::UInt64 || (ErrorCode)rval[0].value_union.ui64 != ErrorCode::Ok;
+
+		std::unique_lock<std::mutex> ulock(profiler_mtx);
+		FunctionStatistics &stats = profiler_functions[cname + "::" + fname];
+		stats.calls++;
+		stats.errors += failed ? 1 : 0;
+		stats.total_us += us;
+		stats.max_us = std::max(stats.max_us, us);
+		stats.arg_bytes += call_arg_bytes;
+		stats.reply_bytes += reply_bytes;
+		stats.histogram[BucketIndex(us)]++;
+	}
+
+	osn::Profiler::call_hook_t forward = forward_post;
+	if (forward)
+		forward(cname, fname, rval, forward_data);
+}
+
+static std::vector<std::pair<std::string, FunctionStatistics>> Snapshot()
+{
+	std::unique_lock<std::mutex> ulock(profiler_mtx);
+	return std::vector<std::pair<std::string, FunctionStatistics>>(profiler_functions.begin(), profiler_functions.end());
+}
+
+static void LogStatistics()
+{
+	auto functions = Snapshot();
+	if (functions.empty())
+		return;
+
+	// The functions the server spent the most time in come first.
+	std::sort(functions.begin(), functions.end(), [](const auto &a, const auto &b) { return a.second.total_us > b.second.total_us; });
+	if (functions.size() > PROFILER_LOG_ENTRIES)
+		functions.resize(PROFILER_LOG_ENTRIES);
+
+	blog(LOG_INFO, "IPC profile, %zu busiest functions:", functions.size());
+	for (auto &function : functions) {
+		const FunctionStatistics &stats = function.second;
+		blog(LOG_INFO,
+		     "  %s: %" PRIu64 " calls (%" PRIu64 " failed), total %" PRIu64 "us, p50 %" PRIu64 "us, p99 %" PRIu64 "us, max %" PRIu64
+		     "us, args %" PRIu64 " bytes, replies %" PRIu64 " bytes",
+		     function.first.c_str(), stats.calls, stats.errors, stats.total_us, Percentile(stats, 0.5), Percentile(stats, 0.99), stats.max_us,
+		     stats.arg_bytes, stats.reply_bytes);
+	}
+}
+
+static void LogWorker()
+{
+	std::unique_lock<std::mutex> ulock(profiler_log_mtx);
+	while (profiler_log_interval) {
+		uint32_t interval = profiler_log_interval;
+		if (profiler_log_cv.wait_for(ulock, std::chrono::seconds(interval), [interval] { return profiler_log_interval != interval; }))
+			continue;
+
+		ulock.unlock();
+		if (profiler_enabled)
+			LogStatistics();
+		ulock.lock();
+	}
+}
+
+static void SetLogging(uint32_t interval)
+{
+	std::thread worker;
+	{
+		std::unique_lock<std::mutex> ulock(profiler_log_mtx);
+		profiler_log_interval = interval;
+		if (interval && !profiler_log_worker.joinable()) {
+			profiler_log_worker = std::thread(LogWorker);
+			return;
+		}
+		if (interval)
+			return;
+		worker.swap(profiler_log_worker);
+	}
+
+	profiler_log_cv.notify_all();
+	if (worker.joinable())
+		worker.join();
+}
+
+void osn::Profiler::Register(ipc::server &srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Profiler");
+	cls->register_function(std::make_shared<ipc::function>("SetEnabled", std::vector<ipc::type>{ipc::type::UInt32}, SetEnabled));
+	cls->register_function(std::make_shared<ipc::function>("IsEnabled", std::vector<ipc::type>{}, IsEnabled));
+	cls->register_function(std::make_shared<ipc::function>("SetLogInterval", std::vector<ipc::type>{ipc::type::UInt32}, SetLogInterval));
+	cls->register_function(std::make_shared<ipc::function>("GetStatistics", std::vector<ipc::type>{}, GetStatistics));
+	cls->register_function(std::make_shared<ipc::function>("Reset", std::vector<ipc::type>{}, Reset));
+	srv.register_collection(cls);
+
+	srv.set_pre_callback(PreServerCall, nullptr);
+	srv.set_post_callback(PostServerCall, nullptr);
+}
+
+void osn::Profiler::SetForwardHooks(call_hook_t pre, call_hook_t post, void *data)
+{
+	forward_data = data;
+	forward_pre = pre;
+	forward_post = post;
+}
+
+void osn::Profiler::Nested(const std::string &cname, const std::string &fname, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval,
+			   const std::function<void()> &call)
+{
+	// The hooks keep the call in flight per thread, the outer one is restored.
+	auto outer_start = call_start;
+	auto outer_arg_bytes = call_arg_bytes;
+	auto outer_profiled = call_profiled;
+
+	PreServerCall(cname, fname, args, nullptr);
+	call();
+	PostServerCall(cname, fname, rval, nullptr);
+
+	call_start = outer_start;
+	call_arg_bytes = outer_arg_bytes;
+	call_profiled = outer_profiled;
+}
+
+void osn::Profiler::Stop()
+{
+	SetLogging(0);
+	profiler_enabled = false;
+}
+
+void osn::Profiler::SetEnabled(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	profiler_enabled = args[0].value_union.ui32 != 0;
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Profiler::IsEnabled(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(uint32_t(profiler_enabled)));
+	AUTO_DEBUG;
+}
+
+void osn::Profiler::SetLogInterval(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	SetLogging(args[0].value_union.ui32);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Profiler::GetStatistics(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	auto functions = Snapshot();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(uint32_t(functions.size())));
+	for (auto &function : functions) {
+		const FunctionStatistics &stats = function.second;
+		rval.push_back(ipc::value(function.first));
+		rval.push_back(ipc::value(stats.calls));
+		rval.push_back(ipc::value(stats.errors));
+		rval.push_back(ipc::value(stats.total_us));
+		rval.push_back(ipc::value(stats.max_us));
+		rval.push_back(ipc::value(Percentile(stats, 0.5)));
+		rval.push_back(ipc::value(Percentile(stats, 0.9)));
+		rval.push_back(ipc::value(Percentile(stats, 0.99)));
+		rval.push_back(ipc::value(stats.arg_bytes));
+		rval.push_back(ipc::value(stats.reply_bytes));
+	}
+	AUTO_DEBUG;
+}
+
+void osn::Profiler::Reset(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	{
+		std::unique_lock<std::mutex> ulock(profiler_mtx);
+		profiler_functions.clear();
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
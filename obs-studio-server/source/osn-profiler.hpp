@@ -0,0 +1,55 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+#pragma once
+#include <ipc-server.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace osn {
+// Per function IPC statistics: call count, latency histogram and the size of
+// the arguments and replies of every collection::function. It is disabled by
+// default, and while disabled the server hooks only test a flag.
+class Profiler {
+public:
+	typedef void (*call_hook_t)(std::string cname, std::string fname, const std::vector<ipc::value> &args, void *data);
+
+	// Installs the pre and post call hooks on the server.
+	static void Register(ipc::server &);
+
+	// The server only has a single pre and post callback, other observers of
+	// server calls (like the crash manager) are forwarded from the profiler.
+	static void SetForwardHooks(call_hook_t pre, call_hook_t post, void *data);
+
+	// Runs `call` between the hooks, for calls dispatched from within another
+	// call like the ones of a batch. The outer call is still profiled as a whole.
+	static void Nested(const std::string &cname, const std::string &fname, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval,
+			   const std::function<void()> &call);
+
+	// Stops the periodic log dump, before the log handler goes away.
+	static void Stop();
+
+	static void SetEnabled(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void IsEnabled(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void SetLogInterval(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void GetStatistics(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void Reset(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+};
+} // namespace osn
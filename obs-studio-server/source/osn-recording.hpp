@@ -31,6 +31,7 @@ public:
 	{
 		videoEncoder = nullptr;
 		signals = {"start", "stop", "stopping", "wrote"};
+		outputType = "recording";
 		enableFileSplit = false;
 		splitType = SplitFileType::TIME;
 		splitTime = 15;
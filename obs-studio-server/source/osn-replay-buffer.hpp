@@ -32,6 +32,7 @@ public:
 		suffix = "";
 		usesStream = false;
 		signals = {"start", "stop", "stopping", "writing", "wrote", "writing_error"};
+		outputType = "replay-buffer";
 	}
 	virtual ~ReplayBuffer();
 
@@ -18,7 +18,9 @@
 
 #include "osn-scene.hpp"
 #include <list>
+#include "osn-coalescer.hpp"
 #include "osn-error.hpp"
+#include "osn-scene-snapshot.hpp"
 #include "osn-sceneitem.hpp"
 #include "osn-video.hpp"
 #include "shared.hpp"
@@ -55,6 +57,9 @@ void osn::Scene::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("OrderItems", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, OrderItems));
 	cls->register_function(std::make_shared<ipc::function>("GetItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, GetItem));
 	cls->register_function(std::make_shared<ipc::function>("GetItems", std::vector<ipc::type>{ipc::type::UInt64}, GetItems));
+	cls->register_function(std::make_shared<ipc::function>("GetItemsSnapshot", std::vector<ipc::type>{ipc::type::UInt64}, GetItemsSnapshot));
+	cls->register_function(
+		std::make_shared<ipc::function>("ApplyTransforms", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, ApplyTransforms));
 	cls->register_function(std::make_shared<ipc::function>("GetItemsInRange", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32},
 							       GetItemsInRange));
 
@@ -143,6 +148,9 @@ void osn::Scene::Release(void *data, const int64_t id, const std::vector<ipc::va
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
 	}
 
+	osn::Coalescer::Discard("Input", args[0].value_union.ui64);
+	DiscardPendingItems(scene);
+
 	std::list<obs_sceneitem_t *> items;
 	auto cb = [](obs_scene_t *scene, obs_sceneitem_t *item, void *data) {
 		std::list<obs_sceneitem_t *> *items = reinterpret_cast<std::list<obs_sceneitem_t *> *>(data);
@@ -175,6 +183,9 @@ void osn::Scene::Remove(void *data, const int64_t id, const std::vector<ipc::val
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
 	}
 
+	osn::Coalescer::Discard("Input", args[0].value_union.ui64);
+	DiscardPendingItems(scene);
+
 	std::list<obs_sceneitem_t *> items;
 	auto cb = [](obs_scene_t *scene, obs_sceneitem_t *item, void *data) {
 		std::list<obs_sceneitem_t *> *items = reinterpret_cast<std::list<obs_sceneitem_t *> *>(data);
@@ -569,6 +580,155 @@ void osn::Scene::GetItems(void *data, const int64_t id, const std::vector<ipc::v
 	AUTO_DEBUG;
 }
 
+void osn::Scene::GetItemsSnapshot(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	obs_source_t *source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
+	}
+
+	obs_scene_t *scene = obs_scene_from_source(source);
+	if (!scene) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
+	}
+
+	struct EnumData {
+		std::vector<osn::SceneItemSnapshot> items;
+		bool failed = false;
+	} ed;
+
+	// Everything is read in one pass under the scene lock, so the snapshot
+	// is consistent with the order of the items.
+	auto cb = [](obs_scene_t *scene, obs_sceneitem_t *item, void *data) {
+		EnumData *ed = reinterpret_cast<EnumData *>(data);
+
+		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+		if (uid == UINT64_MAX) {
+			uid = osn::SceneItem::Manager::GetInstance().allocate(item);
+			if (uid == UINT64_MAX) {
+				ed->failed = true;
+				return false;
+			}
+			obs_sceneitem_addref(item);
+		}
+
+		osn::SceneItemSnapshot snapshot = {};
+		snapshot.item = uid;
+		snapshot.source = osn::Source::Manager::GetInstance().find(obs_sceneitem_get_source(item));
+		snapshot.obs_id = obs_sceneitem_get_id(item);
+
+		vec2 pos, scale;
+		obs_sceneitem_get_pos(item, &pos);
+		obs_sceneitem_get_scale(item, &scale);
+		snapshot.pos_x = pos.x;
+		snapshot.pos_y = pos.y;
+		snapshot.scale_x = scale.x;
+		snapshot.scale_y = scale.y;
+		snapshot.rotation = obs_sceneitem_get_rot(item);
+
+		obs_sceneitem_crop crop;
+		obs_sceneitem_get_crop(item, &crop);
+		snapshot.crop_left = crop.left;
+		snapshot.crop_top = crop.top;
+		snapshot.crop_right = crop.right;
+		snapshot.crop_bottom = crop.bottom;
+
+		snapshot.scale_filter = obs_sceneitem_get_scale_filter(item);
+		snapshot.blending_mode = obs_sceneitem_get_blending_mode(item);
+		snapshot.blending_method = obs_sceneitem_get_blending_method(item);
+
+		snapshot.visible = obs_sceneitem_visible(item);
+		snapshot.selected = obs_sceneitem_selected(item);
+		snapshot.stream_visible = obs_sceneitem_stream_visible(item);
+		snapshot.recording_visible = obs_sceneitem_recording_visible(item);
+
+		ed->items.push_back(snapshot);
+		return true;
+	};
+	obs_scene_enum_items(scene, cb, &ed);
+
+	if (ed.failed) {
+		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
+	}
+
+	std::vector<char> buffer;
+	osn::write_scene_snapshot(ed.items, buffer);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(buffer));
+	AUTO_DEBUG;
+}
+
+void osn::Scene::ApplyTransforms(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	obs_source_t *source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
+	}
+
+	obs_scene_t *scene = obs_scene_from_source(source);
+	if (!scene) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
+	}
+
+	struct UpdateData {
+		std::vector<osn::SceneItemTransform> transforms;
+		uint32_t applied = 0;
+	} ud;
+
+	if (!osn::read_scene_transforms(args[1].value_bin, ud.transforms)) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Malformed transform list.");
+	}
+
+	// Pending single setters are older than this call and must not override it.
+	osn::Coalescer::Flush();
+
+	// The whole set is applied under the scene lock and every item defers its
+	// transform update until all of its fields are set, so the renderer never
+	// sees a partially moved selection.
+	auto cb = [](void *data, obs_scene_t *scene) {
+		UpdateData *ud = reinterpret_cast<UpdateData *>(data);
+
+		for (auto &transform : ud->transforms) {
+			obs_sceneitem_t *item = osn::SceneItem::Manager::GetInstance().find(transform.item);
+			if (!item || obs_sceneitem_get_scene(item) != scene)
+				continue;
+
+			obs_sceneitem_defer_update_begin(item);
+			if (transform.mask & osn::TransformPosition) {
+				vec2 pos;
+				pos.x = transform.pos_x;
+				pos.y = transform.pos_y;
+				obs_sceneitem_set_pos(item, &pos);
+			}
+			if (transform.mask & osn::TransformScale) {
+				vec2 scale;
+				scale.x = transform.scale_x;
+				scale.y = transform.scale_y;
+				obs_sceneitem_set_scale(item, &scale);
+			}
+			if (transform.mask & osn::TransformRotation)
+				obs_sceneitem_set_rot(item, transform.rotation);
+			if (transform.mask & osn::TransformCrop) {
+				obs_sceneitem_crop crop;
+				crop.left = transform.crop_left;
+				crop.top = transform.crop_top;
+				crop.right = transform.crop_right;
+				crop.bottom = transform.crop_bottom;
+				obs_sceneitem_set_crop(item, &crop);
+			}
+			obs_sceneitem_defer_update_end(item);
+
+			ud->applied++;
+		}
+	};
+	obs_scene_atomic_update(scene, cb, &ud);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(ud.applied));
+	AUTO_DEBUG;
+}
+
 void osn::Scene::GetItemsInRange(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	obs_source_t *source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
@@ -627,3 +787,20 @@ void osn::Scene::Disconnect(void *data, const int64_t id, const std::vector<ipc:
 	AUTO_DEBUG;
 	// !FIXME! Signals
 }
+
+void osn::Scene::DiscardPendingItems(obs_scene_t *scene)
+{
+	// The scene is locked while enumerating, the calls are discarded afterwards.
+	std::vector<uint64_t> uids;
+	auto cb = [](obs_scene_t *scene, obs_sceneitem_t *item, void *data) {
+		std::vector<uint64_t> *uids = reinterpret_cast<std::vector<uint64_t> *>(data);
+		uint64_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+		if (uid != UINT64_MAX)
+			uids->push_back(uid);
+		return true;
+	};
+	obs_scene_enum_items(scene, cb, &uids);
+
+	for (auto uid : uids)
+		osn::Coalescer::Discard("SceneItem", uid);
+}
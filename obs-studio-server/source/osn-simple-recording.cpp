@@ -65,10 +65,12 @@ void osn::ISimpleRecording::Register(ipc::server &srv)
 
 void osn::ISimpleRecording::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	uint64_t uid = osn::ISimpleRecording::Manager::GetInstance().allocate(new SimpleRecording());
+	SimpleRecording *recording = new SimpleRecording();
+	uint64_t uid = osn::ISimpleRecording::Manager::GetInstance().allocate(recording);
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+	recording->uid = uid;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
@@ -548,6 +550,7 @@ void osn::ISimpleRecording::GetLegacySettings(void *data, const int64_t id, cons
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+	recording->uid = uid;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
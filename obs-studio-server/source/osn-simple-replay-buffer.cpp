@@ -51,10 +51,12 @@ void osn::ISimpleReplayBuffer::Register(ipc::server &srv)
 
 void osn::ISimpleReplayBuffer::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	uint64_t uid = osn::ISimpleReplayBuffer::Manager::GetInstance().allocate(new SimpleReplayBuffer());
+	SimpleReplayBuffer *replayBuffer = new SimpleReplayBuffer();
+	uint64_t uid = osn::ISimpleReplayBuffer::Manager::GetInstance().allocate(replayBuffer);
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+	replayBuffer->uid = uid;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
@@ -203,6 +205,7 @@ void osn::ISimpleReplayBuffer::GetLegacySettings(void *data, const int64_t id, c
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+	replayBuffer->uid = uid;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
@@ -66,10 +66,12 @@ void osn::ISimpleStreaming::Register(ipc::server &srv)
 
 void osn::ISimpleStreaming::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	uint64_t uid = osn::ISimpleStreaming::Manager::GetInstance().allocate(new SimpleStreaming());
+	SimpleStreaming *streaming = new SimpleStreaming();
+	uint64_t uid = osn::ISimpleStreaming::Manager::GetInstance().allocate(streaming);
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+	streaming->uid = uid;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
@@ -527,6 +529,7 @@ void osn::ISimpleStreaming::GetLegacySettings(void *data, const int64_t id, cons
 	if (uid == UINT64_MAX) {
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+	streaming->uid = uid;
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
@@ -23,14 +23,21 @@
 #include <ipc-value.hpp>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <obs-data.h>
 #include <obs.h>
 #include <obs.hpp>
 #include "osn-error.hpp"
+#include "osn-coalescer.hpp"
 #include "osn-common.hpp"
+#include "osn-scene.hpp"
 #include "shared.hpp"
 #include "callback-manager.h"
 #include "memory-manager.h"
+#include "osn-event-channel.hpp"
+
+static std::mutex versions_mtx;
+static std::unordered_map<obs_source_t *, uint64_t> versions;
 
 void osn::Source::initialize_global_signals()
 {
@@ -53,6 +60,11 @@ void osn::Source::attach_source_signals(obs_source_t *src)
 		return;
 	signal_handler_connect(sh, "destroy", osn::Source::global_source_destroy_cb, nullptr);
 	signal_handler_connect(sh, "remove", osn::Source::global_source_remove_cb, nullptr);
+	signal_handler_connect(sh, "update", osn::Source::global_source_update_cb, nullptr);
+	signal_handler_connect(sh, "update_properties", osn::Source::global_source_update_properties_cb, nullptr);
+	signal_handler_connect(sh, "filter_add", osn::Source::global_source_filters_cb, nullptr);
+	signal_handler_connect(sh, "filter_remove", osn::Source::global_source_filters_cb, nullptr);
+	signal_handler_connect(sh, "reorder_filters", osn::Source::global_source_filters_cb, nullptr);
 }
 
 void osn::Source::detach_source_signals(obs_source_t *src)
@@ -60,10 +72,71 @@ void osn::Source::detach_source_signals(obs_source_t *src)
 	signal_handler_t *sh = obs_source_get_signal_handler(src);
 	if (!sh)
 		return;
+	signal_handler_disconnect(sh, "reorder_filters", osn::Source::global_source_filters_cb, nullptr);
+	signal_handler_disconnect(sh, "filter_remove", osn::Source::global_source_filters_cb, nullptr);
+	signal_handler_disconnect(sh, "filter_add", osn::Source::global_source_filters_cb, nullptr);
+	signal_handler_disconnect(sh, "update_properties", osn::Source::global_source_update_properties_cb, nullptr);
+	signal_handler_disconnect(sh, "update", osn::Source::global_source_update_cb, nullptr);
 	signal_handler_disconnect(sh, "remove", osn::Source::global_source_remove_cb, nullptr);
 	signal_handler_disconnect(sh, "destroy", osn::Source::global_source_destroy_cb, nullptr);
 }
 
+uint64_t osn::Source::GetVersion(obs_source_t *src)
+{
+	std::unique_lock<std::mutex> ulock(versions_mtx);
+	auto iter = versions.find(src);
+	return iter != versions.end() ? iter->second : 0;
+}
+
+void osn::Source::Invalidate(obs_source_t *src, uint32_t what)
+{
+	uint64_t version;
+	{
+		std::unique_lock<std::mutex> ulock(versions_mtx);
+		version = ++versions[src];
+	}
+
+	if (!osn::EventChannel::IsOpen(osn::EventType::SourceInvalidated))
+		return;
+
+	uint64_t uid = osn::Source::Manager::GetInstance().find(src);
+	if (uid == UINT64_MAX)
+		return;
+
+	// Later changes of the same kind replace queued ones, only the newest
+	// version matters to the client.
+	osn::EventChannel::Push(osn::EventType::SourceInvalidated, {ipc::value(uid), ipc::value(version), ipc::value(what)},
+				"invalidate:" + std::to_string(uid) + ":" + std::to_string(what));
+}
+
+void osn::Source::global_source_update_cb(void *ptr, calldata_t *cd)
+{
+	obs_source_t *source = nullptr;
+	if (!calldata_get_ptr(cd, "source", &source))
+		return;
+
+	// Properties often depend on the settings, e.g. lists of devices.
+	Invalidate(source, osn::SourceSettings | osn::SourceProperties);
+}
+
+void osn::Source::global_source_update_properties_cb(void *ptr, calldata_t *cd)
+{
+	obs_source_t *source = nullptr;
+	if (!calldata_get_ptr(cd, "source", &source))
+		return;
+
+	Invalidate(source, osn::SourceProperties);
+}
+
+void osn::Source::global_source_filters_cb(void *ptr, calldata_t *cd)
+{
+	obs_source_t *source = nullptr;
+	if (!calldata_get_ptr(cd, "source", &source))
+		return;
+
+	Invalidate(source, osn::SourceFilters);
+}
+
 void osn::Source::global_source_create_cb(void *ptr, calldata_t *cd)
 {
 	obs_source_t *source = nullptr;
@@ -105,6 +178,9 @@ void osn::Source::global_source_destroy_cb(void *ptr, calldata_t *cd)
 	CallbackManager::removeSource(source);
 	detach_source_signals(source);
 	osn::Source::Manager::GetInstance().free(source);
+
+	std::unique_lock<std::mutex> ulock(versions_mtx);
+	versions.erase(source);
 }
 
 void osn::Source::global_source_remove_cb(void *ptr, calldata_t *cd)
@@ -203,10 +279,17 @@ void osn::Source::Release(void *data, const int64_t id, const std::vector<ipc::v
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
 	}
 
+	// Releasing may free the source and, for scenes, their items.
+	osn::Coalescer::Discard("Input", args[0].value_union.ui64);
+
 	if (obs_source_get_type(src) == OBS_SOURCE_TYPE_TRANSITION) {
 		obs_source_release(src);
 	} else if (obs_source_get_type(src) == OBS_SOURCE_TYPE_SCENE) {
 		blog(LOG_INFO, "Releasing scene %s", obs_source_get_name(src));
+		obs_scene_t *scene = obs_scene_from_source(src);
+		if (scene)
+			osn::Scene::DiscardPendingItems(scene);
+
 		std::list<obs_sceneitem_t *> items;
 		auto cb = [](obs_scene_t *scene, obs_sceneitem_t *item, void *data) {
 			if (item) {
@@ -216,7 +299,6 @@ void osn::Source::Release(void *data, const int64_t id, const std::vector<ipc::v
 			}
 			return true;
 		};
-		obs_scene_t *scene = obs_scene_from_source(src);
 		if (scene)
 			obs_scene_enum_items(scene, cb, &items);
 
@@ -255,7 +337,10 @@ void osn::Source::GetProperties(void *data, const int64_t id, const std::vector<
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
 	}
 
+	// See GetSettings for why the version is read first.
+	uint64_t version = GetVersion(src);
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(version));
 
 	obs_properties_t *prp = obs_source_properties(src);
 	obs_data *settings = obs_source_get_settings(src);
@@ -318,9 +403,13 @@ void osn::Source::GetSettings(void *data, const int64_t id, const std::vector<ip
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
 	}
 
+	// The version is read first, a change racing with this call leaves the
+	// client with an older version and a later invalidation.
+	uint64_t version = GetVersion(src);
 	obs_data_t *sets = obs_source_get_settings(src);
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(obs_data_get_json_pretty(sets)));
+	rval.push_back(ipc::value(version));
 	obs_data_release(sets);
 	AUTO_DEBUG;
 }
@@ -350,10 +439,12 @@ void osn::Source::Update(void *data, const int64_t id, const std::vector<ipc::va
 	MemoryManager::GetInstance().updateSourceCache(src);
 	obs_data_release(sets);
 
+	uint64_t version = GetVersion(src);
 	obs_data_t *updatedSettings = obs_source_get_settings(src);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(obs_data_get_json_pretty(updatedSettings)));
+	rval.push_back(ipc::value(version));
 	obs_data_release(updatedSettings);
 	AUTO_DEBUG;
 }
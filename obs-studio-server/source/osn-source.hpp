@@ -49,9 +49,18 @@ public:
 	static void global_source_destroy_cb(void *ptr, calldata_t *cd);
 	static void global_source_remove_cb(void *ptr, calldata_t *cd);
 
+	static void global_source_update_cb(void *ptr, calldata_t *cd);
+	static void global_source_update_properties_cb(void *ptr, calldata_t *cd);
+	static void global_source_filters_cb(void *ptr, calldata_t *cd);
+
 	static void attach_source_signals(obs_source_t *src);
 	static void detach_source_signals(obs_source_t *src);
 
+	// Bumped whenever the settings, properties or filters of a source change
+	// on the server. Clients compare it against the version of their cache.
+	static uint64_t GetVersion(obs_source_t *src);
+	static void Invalidate(obs_source_t *src, uint32_t what);
+
 public:
 	static void Register(ipc::server &);
 
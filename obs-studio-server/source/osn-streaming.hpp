@@ -41,6 +41,7 @@ public:
 		oldMixer_desktopSource1 = 0;
 		oldMixer_desktopSource2 = 0;
 		signals = {"start", "stop", "starting", "stopping", "activate", "deactivate", "reconnect", "reconnect_success"};
+		outputType = "streaming";
 		delay = new Delay();
 		reconnect = new Reconnect();
 		network = new Network();
@@ -18,14 +18,44 @@
 
 #include "osn-volmeter.hpp"
 #include "osn-error.hpp"
+#include "osn-event-channel.hpp"
 #include "obs.h"
 #include "osn-source.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
+#include <thread>
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 std::mutex mtx;
 
+static_assert(MAX_AUDIO_CHANNELS <= osn::VOLMETER_MAX_CHANNELS, "Volmeter frames are too small for libobs channels.");
+
+// Shared with the client, see osn-volmeter-ring.hpp. The publisher thread is
+// its only producer, ring_mtx only guards its creation.
+static osn::VolmeterRing ring;
+static std::mutex ring_mtx;
+static std::atomic<bool> ring_active(false);
+
+// Audio callbacks only store the snapshot of their meter. The publisher thread
+// forwards new snapshots to the ring and the event channel, so that nothing
+// on the audio threads locks or allocates.
+static constexpr auto PUBLISH_INTERVAL = std::chrono::milliseconds(10);
+// Attempts of a reader before it gives up on a snapshot being written.
+static constexpr int SNAPSHOT_READ_ATTEMPTS = 4;
+
+static std::thread publisher;
+static std::mutex publisher_mtx;
+static std::condition_variable publisher_cv;
+static bool publisher_stop = false;
+
 osn::Volmeter::Manager &osn::Volmeter::Manager::GetInstance()
 {
 	static Manager _inst;
@@ -42,6 +72,60 @@ osn::Volmeter::Volmeter(obs_fader_type type)
 osn::Volmeter::~Volmeter()
 {
 	obs_volmeter_destroy(self);
+	obs_weak_source_release(weak_source);
+}
+
+osn::Volmeter::AudioSnapshot::AudioSnapshot()
+{
+	for (size_t ch = 0; ch < MAX_AUDIO_CHANNELS; ch++) {
+		magnitude[ch].store(-65535.0f, std::memory_order_relaxed);
+		peak[ch].store(-65535.0f, std::memory_order_relaxed);
+		input_peak[ch].store(-65535.0f, std::memory_order_relaxed);
+	}
+}
+
+void osn::Volmeter::AudioSnapshot::Store(const AudioData &data)
+{
+	// An odd sequence marks a write in progress.
+	uint32_t seq = sequence.load(std::memory_order_relaxed);
+	sequence.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	ch.store(data.ch, std::memory_order_relaxed);
+	lastUpdateTime.store(data.lastUpdateTime.count(), std::memory_order_relaxed);
+	for (size_t idx = 0; idx < MAX_AUDIO_CHANNELS; idx++) {
+		magnitude[idx].store(data.magnitude[idx], std::memory_order_relaxed);
+		peak[idx].store(data.peak[idx], std::memory_order_relaxed);
+		input_peak[idx].store(data.input_peak[idx], std::memory_order_relaxed);
+	}
+
+	sequence.store(seq + 2, std::memory_order_release);
+}
+
+bool osn::Volmeter::AudioSnapshot::Load(AudioData &data) const
+{
+	// data is left untouched if every attempt overlaps a write.
+	AudioData read;
+	for (int attempt = 0; attempt < SNAPSHOT_READ_ATTEMPTS; attempt++) {
+		uint32_t seq = sequence.load(std::memory_order_acquire);
+		if (seq & 1)
+			continue;
+
+		read.ch = ch.load(std::memory_order_relaxed);
+		read.lastUpdateTime = std::chrono::milliseconds(lastUpdateTime.load(std::memory_order_relaxed));
+		for (size_t idx = 0; idx < MAX_AUDIO_CHANNELS; idx++) {
+			read.magnitude[idx] = magnitude[idx].load(std::memory_order_relaxed);
+			read.peak[idx] = peak[idx].load(std::memory_order_relaxed);
+			read.input_peak[idx] = input_peak[idx].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (sequence.load(std::memory_order_relaxed) == seq) {
+			data = read;
+			return true;
+		}
+	}
+	return false;
 }
 
 void osn::Volmeter::Register(ipc::server &srv)
@@ -51,17 +135,96 @@ void osn::Volmeter::Register(ipc::server &srv)
 	cls->register_function(std::make_shared<ipc::function>("Destroy", std::vector<ipc::type>{ipc::type::UInt64}, Destroy));
 	cls->register_function(std::make_shared<ipc::function>("Attach", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Attach));
 	cls->register_function(std::make_shared<ipc::function>("Detach", std::vector<ipc::type>{ipc::type::UInt64}, Detach));
+	cls->register_function(std::make_shared<ipc::function>("OpenRing", std::vector<ipc::type>{}, OpenRing));
+	cls->register_function(std::make_shared<ipc::function>("CloseRing", std::vector<ipc::type>{}, CloseRing));
 	srv.register_collection(cls);
 }
 
 void osn::Volmeter::ClearVolmeters()
 {
+	StopPublisher();
+
 	Manager::GetInstance().for_each(
-		[](const std::shared_ptr<osn::Volmeter> &volmeter) { obs_volmeter_remove_callback(volmeter->self, OBSCallback, &volmeter->id); });
+		[](const std::shared_ptr<osn::Volmeter> &volmeter) { obs_volmeter_remove_callback(volmeter->self, OBSCallback, volmeter.get()); });
 
 	Manager::GetInstance().clear();
 }
 
+void osn::Volmeter::StartPublisher()
+{
+	std::unique_lock<std::mutex> ulock(publisher_mtx);
+	if (publisher.joinable())
+		return;
+
+	publisher_stop = false;
+	publisher = std::thread(PublisherThread);
+}
+
+void osn::Volmeter::StopPublisher()
+{
+	{
+		std::unique_lock<std::mutex> ulock(publisher_mtx);
+		if (!publisher.joinable())
+			return;
+
+		publisher_stop = true;
+		publisher_cv.notify_all();
+	}
+	publisher.join();
+}
+
+void osn::Volmeter::PublisherThread()
+{
+	std::unique_lock<std::mutex> ulock(publisher_mtx);
+	while (!publisher_stop) {
+		publisher_cv.wait_for(ulock, PUBLISH_INTERVAL);
+		if (publisher_stop)
+			break;
+
+		ulock.unlock();
+		PublishMeters();
+		ulock.lock();
+	}
+}
+
+void osn::Volmeter::PublishMeters()
+{
+	bool toRing = ring_active;
+	bool toChannel = osn::EventChannel::IsOpen(osn::EventType::Volmeter);
+	if (!toRing && !toChannel)
+		return;
+
+	auto currentTime = GetTime();
+	Manager::GetInstance().for_each([&](const std::shared_ptr<osn::Volmeter> &meter) {
+		if (meter->uid_source == INVALID_ID)
+			return;
+
+		// Retried at the next round if the callback keeps writing meanwhile.
+		AudioData data = meter->published;
+		if (!meter->snapshot.Load(data))
+			return;
+
+		// Muted meters store their snapshot without new levels.
+		if (data.lastUpdateTime != meter->published.lastUpdateTime) {
+			meter->published = data;
+			if (toRing)
+				meter->WriteRing(data);
+			if (toChannel)
+				meter->PushAudioData(data);
+			return;
+		}
+
+		if (!toChannel || !CheckIdle(currentTime, data.lastUpdateTime) || !CheckIdle(currentTime, meter->lastIdlePush))
+			return;
+
+		// Same as getAudioData: idle meters are reported as reset so the UI
+		// keeps presenting them, e.g. after toggling performance mode.
+		data.resetData();
+		meter->lastIdlePush = currentTime;
+		meter->PushAudioData(data);
+	});
+}
+
 void osn::Volmeter::Create(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
 	obs_fader_type type = (obs_fader_type)args[0].value_union.i32;
@@ -80,7 +243,10 @@ void osn::Volmeter::Create(void *data, const int64_t id, const std::vector<ipc::
 		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Failed to allocate unique id for Meter.");
 	}
 
-	obs_volmeter_add_callback(meter->self, OBSCallback, &meter->id);
+	// The callback is removed before the meter is freed, so it can be given
+	// the meter itself instead of looking it up on the audio thread.
+	obs_volmeter_add_callback(meter->self, OBSCallback, meter.get());
+	StartPublisher();
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(meter->id));
@@ -98,7 +264,7 @@ void osn::Volmeter::Destroy(void *data, const int64_t id, const std::vector<ipc:
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid Meter reference.");
 	}
 
-	obs_volmeter_remove_callback(meter->self, OBSCallback, &meter->id);
+	obs_volmeter_remove_callback(meter->self, OBSCallback, meter.get());
 
 	Manager::GetInstance().free(uid);
 
@@ -122,11 +288,14 @@ void osn::Volmeter::Attach(void *data, const int64_t id, const std::vector<ipc::
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid Source reference.");
 	}
 
+	meter->source = source;
 	if (!obs_volmeter_attach_source(meter->self, source)) {
+		meter->source = nullptr;
 		PRETTY_ERROR_RETURN(ErrorCode::Error, "Error attaching source.");
 	}
 
 	meter->uid_source = uid_source;
+	meter->SetWeakSource(source);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
@@ -144,45 +313,139 @@ void osn::Volmeter::Detach(void *data, const int64_t id, const std::vector<ipc::
 
 	meter->uid_source = INVALID_ID;
 	obs_volmeter_detach_source(meter->self);
+	meter->source = nullptr;
+	meter->SetWeakSource(nullptr);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	AUTO_DEBUG;
 }
 
-void osn::Volmeter::OBSCallback(void *param, const float magnitude[MAX_AUDIO_CHANNELS], const float peak[MAX_AUDIO_CHANNELS],
-				const float input_peak[MAX_AUDIO_CHANNELS])
+void osn::Volmeter::OpenRing(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
 {
-	std::unique_lock<std::mutex> ulockMutex(mtx);
-	auto meter = Manager::GetInstance().find(*reinterpret_cast<uint64_t *>(param));
-	if (!meter) {
-		return;
+	std::unique_lock<std::mutex> ulock(ring_mtx);
+#ifdef WIN32
+	std::string name = "Local\\osn-volmeters-" + std::to_string(GetCurrentProcessId());
+#else
+	std::string name = "/osn-vm-" + std::to_string(getpid());
+#endif
+
+	// The ring lives as long as the server, the client may reopen it.
+	if (!ring.IsOpen() && !ring.Create(name)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to create the volmeter ring.");
 	}
+	ring_active = true;
 
-	const auto source = osn::Source::Manager::GetInstance().find(meter->uid_source);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(name));
+	rval.push_back(ipc::value(osn::VolmeterRing::CAPACITY));
+	AUTO_DEBUG;
+}
+
+void osn::Volmeter::CloseRing(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval)
+{
+	ring_active = false;
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Volmeter::WriteRing(const AudioData &data)
+{
+	if (!ring_active)
+		return;
+
+	VolmeterFrame frame;
+	frame.meter_lo = uint32_t(id);
+	frame.meter_hi = uint32_t(id >> 32);
+	frame.channels = uint32_t(data.ch);
+	frame.reserved = 0;
+	std::copy(data.magnitude.begin(), data.magnitude.end(), frame.magnitude);
+	std::copy(data.peak.begin(), data.peak.end(), frame.peak);
+	std::copy(data.input_peak.begin(), data.input_peak.end(), frame.input_peak);
+	std::fill(frame.magnitude + MAX_AUDIO_CHANNELS, frame.magnitude + VOLMETER_MAX_CHANNELS, -65535.0f);
+	std::fill(frame.peak + MAX_AUDIO_CHANNELS, frame.peak + VOLMETER_MAX_CHANNELS, -65535.0f);
+	std::fill(frame.input_peak + MAX_AUDIO_CHANNELS, frame.input_peak + VOLMETER_MAX_CHANNELS, -65535.0f);
+
+	ring.Push(frame);
+}
+
+void osn::Volmeter::OBSCallback(void *param, const float magnitude[MAX_AUDIO_CHANNELS], const float peak[MAX_AUDIO_CHANNELS],
+				const float input_peak[MAX_AUDIO_CHANNELS])
+{
+	// Runs on the audio thread, nothing here may lock, allocate or wait on
+	// IPC handlers. The publisher thread picks up the snapshot.
+	auto meter = reinterpret_cast<osn::Volmeter *>(param);
+	obs_source_t *source = meter->source;
 	if (!source) {
 		return;
 	}
 
-	std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
-	meter->current_data.ch = obs_volmeter_get_nr_channels(meter->self);
+	AudioData &data = meter->current_data;
+	data.ch = obs_volmeter_get_nr_channels(meter->self);
 
 	const bool isMuted = obs_source_muted(source);
 	if (isMuted) {
+		meter->snapshot.Store(data);
 		return;
 	}
 
-	meter->current_data.lastUpdateTime = GetTime();
+	data.lastUpdateTime = GetTime();
 
 #define MAKE_FLOAT_SANE(db) (std::isfinite(db) ? db : (db > 0 ? 0.0f : -65535.0f))
 #define PREVIOUS_FRAME_WEIGHT
 
-	for (size_t ch = 0; ch < meter->current_data.ch; ch++) {
-		meter->current_data.magnitude[ch] = MAKE_FLOAT_SANE(magnitude[ch]);
-		meter->current_data.peak[ch] = MAKE_FLOAT_SANE(peak[ch]);
-		meter->current_data.input_peak[ch] = MAKE_FLOAT_SANE(input_peak[ch]);
+	for (size_t ch = 0; ch < data.ch; ch++) {
+		data.magnitude[ch] = MAKE_FLOAT_SANE(magnitude[ch]);
+		data.peak[ch] = MAKE_FLOAT_SANE(peak[ch]);
+		data.input_peak[ch] = MAKE_FLOAT_SANE(input_peak[ch]);
 	}
 
 #undef MAKE_FLOAT_SANE
+
+	meter->snapshot.Store(data);
+}
+
+void osn::Volmeter::SetWeakSource(obs_source_t *source)
+{
+	obs_weak_source_t *weak = source ? obs_source_get_weak_source(source) : nullptr;
+	{
+		std::unique_lock<std::mutex> ulock(weak_mtx);
+		std::swap(weak, weak_source);
+	}
+	obs_weak_source_release(weak);
+}
+
+obs_source_t *osn::Volmeter::GetSourceRef()
+{
+	std::unique_lock<std::mutex> ulock(weak_mtx);
+	return obs_weak_source_get_source(weak_source);
+}
+
+void osn::Volmeter::PushAudioData(const AudioData &data)
+{
+	if (!osn::EventChannel::IsOpen(osn::EventType::Volmeter))
+		return;
+
+	// Runs on the publisher thread, the reference keeps the source alive if
+	// the IPC thread releases it meanwhile.
+	obs_source_t *source = GetSourceRef();
+	if (!source)
+		return;
+
+	std::vector<ipc::value> values;
+	values.reserve(3 + data.ch * 3);
+	values.push_back(ipc::value(id));
+	values.push_back(ipc::value(obs_source_get_name(source)));
+	values.push_back(ipc::value(data.ch));
+	obs_source_release(source);
+	for (size_t ch = 0; ch < data.ch; ch++) {
+		values.push_back(ipc::value(data.magnitude[ch]));
+		values.push_back(ipc::value(data.peak[ch]));
+		values.push_back(ipc::value(data.input_peak[ch]));
+	}
+
+	// Only the latest frame of each meter is worth sending.
+	osn::EventChannel::Push(osn::EventType::Volmeter, std::move(values), "volmeter:" + std::to_string(id));
 }
 
 std::chrono::milliseconds osn::Volmeter::GetTime()
@@ -205,15 +468,11 @@ bool osn::Volmeter::CheckIdle(std::chrono::milliseconds currentTime, std::chrono
 
 void osn::Volmeter::getAudioData(uint64_t id, std::vector<ipc::value> &rval)
 {
-	std::unique_lock<std::mutex> ulockMutex(mtx);
-
 	auto meter = Manager::GetInstance().find(id);
 	if (!meter) {
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid Meter reference.");
 	}
 
-	std::unique_lock<std::mutex> ulock(meter->current_data_mtx);
-
 	const auto source = osn::Source::Manager::GetInstance().find(meter->uid_source);
 	if (!source) {
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Volmeter source not found.");
@@ -221,9 +480,11 @@ void osn::Volmeter::getAudioData(uint64_t id, std::vector<ipc::value> &rval)
 
 	bool isMuted = obs_source_muted(source);
 
-	if (CheckIdle(GetTime(), meter->current_data.lastUpdateTime)) {
-		meter->current_data.resetData();
-		meter->current_data.lastUpdateTime = GetTime();
+	// A snapshot that could not be read is reported like an idle meter.
+	AudioData data;
+	meter->snapshot.Load(data);
+	if (CheckIdle(GetTime(), data.lastUpdateTime)) {
+		data.resetData();
 
 		// isMuted flag only tells UI if it needs process and visualize volmeters bars.
 		// It does not responsible for any audio processing or source elements state.
@@ -234,15 +495,15 @@ void osn::Volmeter::getAudioData(uint64_t id, std::vector<ipc::value> &rval)
 	}
 
 	rval.push_back(ipc::value(obs_source_get_name(source)));
-	rval.push_back(ipc::value(meter->current_data.ch));
+	rval.push_back(ipc::value(data.ch));
 	rval.push_back(ipc::value(isMuted));
 
 	if (isMuted)
 		return;
 
-	for (size_t ch = 0; ch < meter->current_data.ch; ch++) {
-		rval.push_back(ipc::value(meter->current_data.magnitude[ch]));
-		rval.push_back(ipc::value(meter->current_data.peak[ch]));
-		rval.push_back(ipc::value(meter->current_data.input_peak[ch]));
+	for (size_t ch = 0; ch < data.ch; ch++) {
+		rval.push_back(ipc::value(data.magnitude[ch]));
+		rval.push_back(ipc::value(data.peak[ch]));
+		rval.push_back(ipc::value(data.input_peak[ch]));
 	}
 }
\ No newline at end of file
@@ -21,7 +21,10 @@
 #include <memory>
 #include <queue>
 #include <array>
+#include <atomic>
+#include <mutex>
 #include "obs.h"
+#include "osn-volmeter-ring.hpp"
 #include "utility.hpp"
 
 extern std::mutex mtx;
@@ -50,7 +53,12 @@ private:
 
 	obs_volmeter_t *self = nullptr;
 	utility::unique_id::id_t id = INVALID_ID;
-	utility::unique_id::id_t uid_source = INVALID_ID;
+	std::atomic<utility::unique_id::id_t> uid_source{INVALID_ID};
+	std::atomic<obs_source_t *> source{nullptr};
+	// Lets the publisher thread reference the attached source while the IPC
+	// thread may release it.
+	obs_weak_source_t *weak_source = nullptr;
+	std::mutex weak_mtx;
 
 	struct AudioData {
 		std::array<float, MAX_AUDIO_CHANNELS> magnitude{};
@@ -68,8 +76,33 @@ private:
 		}
 	};
 
+	// Seqlock holding the latest published AudioData. The only writer is the
+	// audio callback of the attached source. Readers make a bounded number of
+	// attempts and give up if they keep overlapping a write, so that neither
+	// side ever blocks.
+	class AudioSnapshot {
+	public:
+		AudioSnapshot();
+
+		void Store(const AudioData &data);
+		bool Load(AudioData &data) const;
+
+	private:
+		std::atomic<uint32_t> sequence{0};
+		std::atomic<int32_t> ch{0};
+		std::atomic<int64_t> lastUpdateTime{0};
+		std::array<std::atomic<float>, MAX_AUDIO_CHANNELS> magnitude;
+		std::array<std::atomic<float>, MAX_AUDIO_CHANNELS> peak;
+		std::array<std::atomic<float>, MAX_AUDIO_CHANNELS> input_peak;
+	};
+
+	// Only touched by the audio callback.
 	AudioData current_data;
-	std::mutex current_data_mtx;
+	AudioSnapshot snapshot;
+
+	// Only touched by the publisher thread.
+	AudioData published;
+	std::chrono::milliseconds lastIdlePush = std::chrono::milliseconds(0);
 
 public:
 	Volmeter(obs_fader_type type);
@@ -87,11 +120,22 @@ public:
 	static void Attach(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 	static void Detach(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
 
+	static void OpenRing(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+	static void CloseRing(void *data, const int64_t id, const std::vector<ipc::value> &args, std::vector<ipc::value> &rval);
+
 	static void OBSCallback(void *param, const float magnitude[MAX_AUDIO_CHANNELS], const float peak[MAX_AUDIO_CHANNELS],
 				const float input_peak[MAX_AUDIO_CHANNELS]);
 
 private:
 	static std::chrono::milliseconds GetTime();
 	static bool CheckIdle(std::chrono::milliseconds currentTime, std::chrono::milliseconds lastUpdateTime);
+	static void StartPublisher();
+	static void StopPublisher();
+	static void PublisherThread();
+	static void PublishMeters();
+	void SetWeakSource(obs_source_t *source);
+	obs_source_t *GetSourceRef();
+	void PushAudioData(const AudioData &data);
+	void WriteRing(const AudioData &data);
 };
 } // namespace osn
\ No newline at end of file
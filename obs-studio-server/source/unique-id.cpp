@@ -0,0 +1,87 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "unique-id.hpp"
+
+static constexpr utility::unique_id::id_t INDEX_MASK = (utility::unique_id::id_t(1) << utility::unique_id::INDEX_BITS) - 1;
+static constexpr uint32_t MAX_GENERATION = (uint32_t(1) << utility::unique_id::GENERATION_BITS) - 1;
+static constexpr utility::unique_id::id_t MAX_SLOTS = INDEX_MASK;
+
+static inline utility::unique_id::id_t make_id(uint32_t index, uint32_t generation)
+{
+	return (utility::unique_id::id_t(generation) << utility::unique_id::INDEX_BITS) | index;
+}
+
+utility::unique_id::unique_id() {}
+
+utility::unique_id::~unique_id() {}
+
+utility::unique_id::id_t utility::unique_id::allocate()
+{
+	uint32_t index;
+	if (!free_slots.empty()) {
+		index = free_slots.front();
+		free_slots.pop_front();
+	} else if (slots.size() < MAX_SLOTS) {
+		index = uint32_t(slots.size());
+		slots.emplace_back();
+	} else {
+		// No more free indexes. However that has happened.
+		return INVALID_ID;
+	}
+
+	slots[index].used = true;
+	used_count++;
+	return make_id(index, slots[index].generation);
+}
+
+void utility::unique_id::free(utility::unique_id::id_t v)
+{
+	if (!is_allocated(v))
+		return;
+
+	uint32_t index = uint32_t(v & INDEX_MASK);
+	slot &s = slots[index];
+	s.used = false;
+	used_count--;
+
+	// A slot whose generation is exhausted is retired instead of wrapping
+	// around to ids that may still be held somewhere.
+	if (s.generation < MAX_GENERATION) {
+		s.generation++;
+		free_slots.push_back(index);
+	}
+}
+
+bool utility::unique_id::is_allocated(utility::unique_id::id_t v)
+{
+	if (v == INVALID_ID)
+		return false;
+
+	id_t index = v & INDEX_MASK;
+	if (index >= slots.size())
+		return false;
+
+	const slot &s = slots[index];
+	return s.used && make_id(uint32_t(index), s.generation) == v;
+}
+
+utility::unique_id::id_t utility::unique_id::count(bool count_free)
+{
+	return count_free ? (MAX_SLOTS - used_count) : used_count;
+}
@@ -0,0 +1,60 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <deque>
+#include <inttypes.h>
+#include <limits>
+#include <vector>
+
+namespace utility {
+// Hands out ids in O(1) from a queue of free slots. An id packs a slot index
+// and the generation of that slot, the generation is bumped on every free so
+// that a stale id is never confused with the object now using the slot.
+// Generation 0 ids are equal to their slot index.
+class unique_id {
+public:
+	typedef uint64_t id_t;
+
+	// Ids must survive a round-trip through a JS number.
+	static constexpr id_t INDEX_BITS = 32;
+	static constexpr id_t GENERATION_BITS = 20;
+	static constexpr id_t INVALID_ID = std::numeric_limits<id_t>::max();
+
+public:
+	unique_id();
+	virtual ~unique_id();
+
+	id_t allocate();
+	void free(id_t);
+
+	bool is_allocated(id_t);
+	id_t count(bool count_free);
+
+private:
+	struct slot {
+		uint32_t generation = 0;
+		bool used = false;
+	};
+
+	std::vector<slot> slots;
+	// Freed slots are reused oldest first, which keeps generations low.
+	std::deque<uint32_t> free_slots;
+	id_t used_count = 0;
+};
+} // namespace utility
@@ -55,6 +55,7 @@
 
 #include "nodeobs_api.h"
 #include "osn-error.hpp"
+#include "osn-log-writer.hpp"
 #include "shared.hpp"
 
 #ifdef ENABLE_CRASHREPORT
@@ -601,6 +602,7 @@ void util::CrashManager::HandleCrash(const std::string &_crashInfo, bool callAbo
 		abort();
 
 	SaveToAppStateFile();
+	osn::LogWriter::Flush();
 
 	annotations.clear();
 
@@ -965,28 +967,23 @@ nlohmann::json util::CrashManager::RequestOBSLog(OBSLogType type)
 {
 	nlohmann::json result;
 
+	// Bounded by the capacity of the log report, whatever the session length.
 	switch (type) {
 	case OBSLogType::Errors: {
-		auto &errors = OBS_API::getOBSLogErrors();
-		for (auto &msg : errors)
+		for (auto &msg : OBS_API::getOBSLog(OBS_API::LogReport::Errors))
 			result.push_back(msg);
 		break;
 	}
 
 	case OBSLogType::Warnings: {
-		auto &warnings = OBS_API::getOBSLogWarnings();
-		for (auto &msg : warnings)
+		for (auto &msg : OBS_API::getOBSLog(OBS_API::LogReport::Warnings))
 			result.push_back(msg);
 		break;
 	}
 
 	case OBSLogType::General: {
-		auto &general = OBS_API::getOBSLogGeneral();
-		while (!general.empty()) {
-			result.push_back(general.front());
-			general.pop();
-		}
-
+		for (auto &msg : OBS_API::getOBSLog(OBS_API::LogReport::General))
+			result.push_back(msg);
 		break;
 	}
 	}
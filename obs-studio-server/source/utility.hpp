@@ -22,8 +22,11 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include <obs.h>
 #include <ipc-server.hpp>
+#include "unique-id.hpp"
 
 #if defined(_MSC_VER)
 #define __PRETTY_FUNCTION__ __FUNCSIG__
@@ -53,36 +56,64 @@
 namespace utility {
 std::string osn_current_version(const std::string &_version = "");
 
-class unique_id {
-public:
-	typedef uint64_t id_t;
-	typedef std::pair<id_t, id_t> range_t;
-
-public:
-	unique_id();
-	virtual ~unique_id();
-
-	id_t allocate();
-	void free(id_t);
+// Keeps an object registered in a unique_object_manager alive while for_each
+// uses it without the lock. Only called while the object is registered, which
+// its owner keeps alive. Objects libobs does not reference count are not
+// pinned, they must only be released by the thread iterating over them.
+template<typename T> struct object_pin {
+	static T *acquire(T *obj) { return obj; }
+	static void release(T *obj) {}
+};
 
-	bool is_allocated(id_t);
-	id_t count(bool count_free);
+template<> struct object_pin<obs_source_t> {
+	// Null once the last reference is gone, the source is being destroyed.
+	static obs_source_t *acquire(obs_source_t *obj) { return obs_source_get_ref(obj); }
+	static void release(obs_source_t *obj) { obs_source_release(obj); }
+};
 
-protected:
-	bool mark_used(id_t);
-	void mark_used_range(id_t, id_t);
-	bool mark_free(id_t);
-	void mark_free_range(id_t, id_t);
+template<> struct object_pin<obs_encoder_t> {
+	static obs_encoder_t *acquire(obs_encoder_t *obj) { return obs_encoder_get_ref(obj); }
+	static void release(obs_encoder_t *obj) { obs_encoder_release(obj); }
+};
 
-private:
-	std::list<range_t> allocated;
+template<> struct object_pin<obs_service_t> {
+	static obs_service_t *acquire(obs_service_t *obj) { return obs_service_get_ref(obj); }
+	static void release(obs_service_t *obj) { obs_service_release(obj); }
 };
 
 template<typename T> class unique_object_manager {
 protected:
 	utility::unique_id id_generator;
 	std::map<utility::unique_id::id_t, T *> object_map;
-	std::recursive_mutex internal_mutex;
+	// Reverse index kept in sync with object_map, so that looking up the id of
+	// an object does not scan every object. An object may be registered under
+	// several ids, the smallest one is reported like a scan of object_map would.
+	std::unordered_multimap<T *, utility::unique_id::id_t> reverse_map;
+	// Lookups only take a shared lock so that IPC handlers and libobs callback
+	// threads do not serialize on each other.
+	std::shared_mutex internal_mutex;
+
+	typename std::unordered_multimap<T *, utility::unique_id::id_t>::iterator find_reverse(T *obj)
+	{
+		auto range = reverse_map.equal_range(obj);
+		auto found = range.first;
+		for (auto iter = range.first; iter != range.second; ++iter) {
+			if (iter->second < found->second)
+				found = iter;
+		}
+		return found != range.second ? found : reverse_map.end();
+	}
+
+	void erase_reverse(T *obj, utility::unique_id::id_t id)
+	{
+		auto range = reverse_map.equal_range(obj);
+		for (auto iter = range.first; iter != range.second; ++iter) {
+			if (iter->second == id) {
+				reverse_map.erase(iter);
+				return;
+			}
+		}
+	}
 
 public:
 	unique_object_manager() {}
@@ -90,30 +121,33 @@ public:
 
 	utility::unique_id::id_t allocate(T *obj)
 	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+		std::unique_lock<std::shared_mutex> lock(internal_mutex);
 
 		utility::unique_id::id_t uid = id_generator.allocate();
 		if (uid == std::numeric_limits<utility::unique_id::id_t>::max()) {
 			return uid;
 		}
+		auto iter = object_map.find(uid);
+		if (iter != object_map.end())
+			erase_reverse(iter->second, uid);
 		object_map.insert_or_assign(uid, obj);
+		reverse_map.emplace(obj, uid);
 		return uid;
 	}
 
 	utility::unique_id::id_t find(T *obj)
 	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+		std::shared_lock<std::shared_mutex> lock(internal_mutex);
 
-		for (auto kv : object_map) {
-			if (kv.second == obj) {
-				return kv.first;
-			}
+		auto iter = find_reverse(obj);
+		if (iter != reverse_map.end()) {
+			return iter->second;
 		}
 		return std::numeric_limits<utility::unique_id::id_t>::max();
 	}
 	T *find(utility::unique_id::id_t id)
 	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+		std::shared_lock<std::shared_mutex> lock(internal_mutex);
 
 		auto iter = object_map.find(id);
 		if (iter != object_map.end()) {
@@ -124,48 +158,103 @@ public:
 
 	utility::unique_id::id_t free(T *obj)
 	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+		std::unique_lock<std::shared_mutex> lock(internal_mutex);
 
-		utility::unique_id::id_t uid = std::numeric_limits<utility::unique_id::id_t>::max();
-		for (auto kv : object_map) {
-			if (kv.second == obj) {
-				uid = kv.first;
-				object_map.erase(kv.first);
-				break;
-			}
+		auto iter = find_reverse(obj);
+		if (iter == reverse_map.end()) {
+			return std::numeric_limits<utility::unique_id::id_t>::max();
 		}
+		utility::unique_id::id_t uid = iter->second;
+		reverse_map.erase(iter);
+		object_map.erase(uid);
+		id_generator.free(uid);
 		return uid;
 	}
 	T *free(utility::unique_id::id_t id)
 	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+		std::unique_lock<std::shared_mutex> lock(internal_mutex);
 
 		auto iter = object_map.find(id);
 		if (iter == object_map.end()) {
 			return nullptr;
 		}
 		T *obj = iter->second;
+		erase_reverse(obj, id);
 		object_map.erase(iter);
+		id_generator.free(id);
 		return obj;
 	}
 
+	// Iterates over a snapshot taken under the lock, so the method may call
+	// back into the manager and other threads may free objects meanwhile.
+	// Objects are pinned by the snapshot (see object_pin) and skipped once
+	// freed.
 	void for_each(std::function<void(T *)> for_each_method)
 	{
-		for (auto it = object_map.begin(); it != object_map.end(); ++it) {
-			for_each_method(it->second);
+		std::vector<std::pair<utility::unique_id::id_t, T *>> snapshot;
+		{
+			std::shared_lock<std::shared_mutex> lock(internal_mutex);
+			snapshot.reserve(object_map.size());
+			for (auto &kv : object_map) {
+				T *pinned = object_pin<T>::acquire(kv.second);
+				if (pinned)
+					snapshot.emplace_back(kv.first, pinned);
+			}
+		}
+		for (auto &kv : snapshot) {
+			if (find(kv.first) == kv.second)
+				for_each_method(kv.second);
+			object_pin<T>::release(kv.second);
 		}
 	}
 
-	size_t size() { return object_map.size(); }
+	size_t size()
+	{
+		std::shared_lock<std::shared_mutex> lock(internal_mutex);
+		return object_map.size();
+	}
 
-	void clear() { object_map.clear(); }
+	void clear()
+	{
+		std::unique_lock<std::shared_mutex> lock(internal_mutex);
+		for (auto &kv : object_map)
+			id_generator.free(kv.first);
+		object_map.clear();
+		reverse_map.clear();
+	}
 };
 
 template<typename T> class generic_object_manager {
 protected:
 	utility::unique_id id_generator;
 	std::map<utility::unique_id::id_t, T> object_map;
-	std::recursive_mutex internal_mutex;
+	// See unique_object_manager::reverse_map.
+	std::unordered_multimap<T, utility::unique_id::id_t> reverse_map;
+	// Lookups only take a shared lock so that IPC handlers and libobs callback
+	// threads do not serialize on each other.
+	std::shared_mutex internal_mutex;
+
+	typename std::unordered_multimap<T, utility::unique_id::id_t>::iterator find_reverse(const T &obj)
+	{
+		auto range = reverse_map.equal_range(obj);
+		auto found = range.first;
+		for (auto iter = range.first; iter != range.second; ++iter) {
+			if (iter->second < found->second)
+				found = iter;
+		}
+		return found != range.second ? found : reverse_map.end();
+	}
+
+	void erase_reverse(const T &obj, utility::unique_id::id_t id)
+	{
+		auto range = reverse_map.equal_range(obj);
+		for (auto iter = range.first; iter != range.second; ++iter) {
+			if (iter->second == id) {
+				reverse_map.erase(iter);
+				return;
+			}
+		}
+	}
 
 public:
 	generic_object_manager() {}
@@ -173,30 +262,33 @@ public:
 
 	utility::unique_id::id_t allocate(T obj)
 	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+		std::unique_lock<std::shared_mutex> lock(internal_mutex);
 
 		utility::unique_id::id_t uid = id_generator.allocate();
 		if (uid == std::numeric_limits<utility::unique_id::id_t>::max()) {
 			return uid;
 		}
+		auto iter = object_map.find(uid);
+		if (iter != object_map.end())
+			erase_reverse(iter->second, uid);
 		object_map.insert_or_assign(uid, obj);
+		reverse_map.emplace(obj, uid);
 		return uid;
 	}
 
 	utility::unique_id::id_t find(T obj)
 	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+		std::shared_lock<std::shared_mutex> lock(internal_mutex);
 
-		for (auto kv : object_map) {
-			if (kv.second == obj) {
-				return kv.first;
-			}
+		auto iter = find_reverse(obj);
+		if (iter != reverse_map.end()) {
+			return iter->second;
 		}
 		return std::numeric_limits<utility::unique_id::id_t>::max();
 	}
 	T find(utility::unique_id::id_t id)
 	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+		std::shared_lock<std::shared_mutex> lock(internal_mutex);
 
 		auto iter = object_map.find(id);
 		if (iter != object_map.end()) {
@@ -207,41 +299,63 @@ public:
 
 	utility::unique_id::id_t free(T obj)
 	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+		std::unique_lock<std::shared_mutex> lock(internal_mutex);
 
-		utility::unique_id::id_t uid = std::numeric_limits<utility::unique_id::id_t>::max();
-		for (auto kv : object_map) {
-			if (kv.second == obj) {
-				uid = kv.first;
-				object_map.erase(kv.first);
-				break;
-			}
+		auto iter = find_reverse(obj);
+		if (iter == reverse_map.end()) {
+			return std::numeric_limits<utility::unique_id::id_t>::max();
 		}
+		utility::unique_id::id_t uid = iter->second;
+		reverse_map.erase(iter);
+		object_map.erase(uid);
+		id_generator.free(uid);
 		return uid;
 	}
 	T free(utility::unique_id::id_t id)
 	{
-		std::lock_guard<std::recursive_mutex> lock(internal_mutex);
+		std::unique_lock<std::shared_mutex> lock(internal_mutex);
 
 		auto iter = object_map.find(id);
 		if (iter == object_map.end()) {
 			return nullptr;
 		}
 		T obj = iter->second;
+		erase_reverse(obj, id);
 		object_map.erase(iter);
+		id_generator.free(id);
 		return obj;
 	}
 
+	// Iterates over copies taken under the lock, which keep shared values alive
+	// while the method runs, so it may call back into the manager.
 	void for_each(std::function<void(T &)> for_each_method)
 	{
-		for (auto it = object_map.begin(); it != object_map.end(); ++it) {
-			for_each_method(it->second);
+		std::vector<T> snapshot;
+		{
+			std::shared_lock<std::shared_mutex> lock(internal_mutex);
+			snapshot.reserve(object_map.size());
+			for (auto &kv : object_map)
+				snapshot.push_back(kv.second);
+		}
+		for (auto &obj : snapshot) {
+			for_each_method(obj);
 		}
 	}
 
-	size_t size() { return object_map.size(); }
+	size_t size()
+	{
+		std::shared_lock<std::shared_mutex> lock(internal_mutex);
+		return object_map.size();
+	}
 
-	void clear() { object_map.clear(); }
+	void clear()
+	{
+		std::unique_lock<std::shared_mutex> lock(internal_mutex);
+		for (auto &kv : object_map)
+			id_generator.free(kv.first);
+		object_map.clear();
+		reverse_map.clear();
+	}
 };
 
 void ProcessProperties(obs_properties_t *prp, obs_data *settings, std::vector<ipc::value> &rval);
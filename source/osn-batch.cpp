@@ -0,0 +1,165 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-batch.hpp"
+#include "osn-serialize.hpp"
+
+using namespace osn::serialize;
+
+void osn::batch::write_value(std::vector<char> &buf, const ipc::value &value)
+{
+	write_pod(buf, uint8_t(value.type));
+	switch (value.type) {
+	case ipc::type::Null:
+		// Null values may carry an error message from the server.
+		write_bytes(buf, value.value_str.data(), value.value_str.size());
+		break;
+	case ipc::type::Float:
+		write_pod(buf, value.value_union.fp32);
+		break;
+	case ipc::type::Double:
+		write_pod(buf, value.value_union.fp64);
+		break;
+	case ipc::type::Int32:
+		write_pod(buf, value.value_union.i32);
+		break;
+	case ipc::type::Int64:
+		write_pod(buf, value.value_union.i64);
+		break;
+	case ipc::type::UInt32:
+		write_pod(buf, value.value_union.ui32);
+		break;
+	case ipc::type::UInt64:
+		write_pod(buf, value.value_union.ui64);
+		break;
+	case ipc::type::String:
+		write_bytes(buf, value.value_str.data(), value.value_str.size());
+		break;
+	case ipc::type::Binary:
+		write_bytes(buf, value.value_bin.data(), value.value_bin.size());
+		break;
+	}
+}
+
+bool osn::batch::read_value(const std::vector<char> &buf, size_t &offset, ipc::value &value)
+{
+	uint8_t type = 0;
+	if (!read_pod(buf, offset, type))
+		return false;
+
+	value = ipc::value();
+	value.type = ipc::type(type);
+	switch (value.type) {
+	case ipc::type::Null:
+		return read_string(buf, offset, value.value_str);
+	case ipc::type::Float:
+		return read_pod(buf, offset, value.value_union.fp32);
+	case ipc::type::Double:
+		return read_pod(buf, offset, value.value_union.fp64);
+	case ipc::type::Int32:
+		return read_pod(buf, offset, value.value_union.i32);
+	case ipc::type::Int64:
+		return read_pod(buf, offset, value.value_union.i64);
+	case ipc::type::UInt32:
+		return read_pod(buf, offset, value.value_union.ui32);
+	case ipc::type::UInt64:
+		return read_pod(buf, offset, value.value_union.ui64);
+	case ipc::type::String:
+		return read_string(buf, offset, value.value_str);
+	case ipc::type::Binary:
+		return read_binary(buf, offset, value.value_bin);
+	}
+	return false;
+}
+
+bool osn::batch::serialize_calls(const std::vector<Call> &calls, std::vector<char> &buf)
+{
+	buf.clear();
+	write_pod(buf, uint32_t(calls.size()));
+	for (auto &call : calls) {
+		write_bytes(buf, call.collection.data(), call.collection.size());
+		write_bytes(buf, call.function.data(), call.function.size());
+		write_pod(buf, uint32_t(call.args.size()));
+		for (auto &arg : call.args)
+			write_value(buf, arg);
+	}
+	return true;
+}
+
+bool osn::batch::deserialize_calls(const std::vector<char> &buf, std::vector<Call> &calls)
+{
+	// Every call takes at least its two string lengths and its argument count.
+	size_t offset = 0;
+	uint32_t count = 0;
+	if (!read_count(buf, offset, count, 3 * sizeof(uint32_t)))
+		return false;
+
+	calls.clear();
+	calls.reserve(count);
+	for (uint32_t idx = 0; idx < count; idx++) {
+		Call call;
+		uint32_t argc = 0;
+		// Every value takes at least its type byte.
+		if (!read_string(buf, offset, call.collection) || !read_string(buf, offset, call.function) || !read_count(buf, offset, argc, 1))
+			return false;
+
+		call.args.resize(argc);
+		for (auto &arg : call.args) {
+			if (!read_value(buf, offset, arg))
+				return false;
+		}
+		calls.push_back(std::move(call));
+	}
+	return true;
+}
+
+bool osn::batch::serialize_results(const std::vector<Result> &results, std::vector<char> &buf)
+{
+	buf.clear();
+	write_pod(buf, uint32_t(results.size()));
+	for (auto &result : results) {
+		write_pod(buf, uint32_t(result.size()));
+		for (auto &value : result)
+			write_value(buf, value);
+	}
+	return true;
+}
+
+bool osn::batch::deserialize_results(const std::vector<char> &buf, std::vector<Result> &results)
+{
+	// Every result takes at least its value count.
+	size_t offset = 0;
+	uint32_t count = 0;
+	if (!read_count(buf, offset, count, sizeof(uint32_t)))
+		return false;
+
+	results.clear();
+	results.resize(count);
+	for (auto &result : results) {
+		uint32_t rvalc = 0;
+		if (!read_count(buf, offset, rvalc, 1))
+			return false;
+
+		result.resize(rvalc);
+		for (auto &value : result) {
+			if (!read_value(buf, offset, value))
+				return false;
+		}
+	}
+	return true;
+}
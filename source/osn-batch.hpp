@@ -0,0 +1,48 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <string>
+#include <vector>
+#include "ipc-value.hpp"
+
+// Wire format shared by the client and the server for the "Batch" collection.
+// A batch carries several (collection, function, args) calls in a single
+// binary argument and returns every reply in a single binary value, so that
+// bulk reads and writes only cost one round-trip.
+namespace osn {
+namespace batch {
+struct Call {
+	std::string collection;
+	std::string function;
+	std::vector<ipc::value> args;
+};
+
+typedef std::vector<ipc::value> Result;
+
+bool serialize_calls(const std::vector<Call> &calls, std::vector<char> &buf);
+bool deserialize_calls(const std::vector<char> &buf, std::vector<Call> &calls);
+
+bool serialize_results(const std::vector<Result> &results, std::vector<char> &buf);
+bool deserialize_results(const std::vector<char> &buf, std::vector<Result> &results);
+
+void write_value(std::vector<char> &buf, const ipc::value &value);
+bool read_value(const std::vector<char> &buf, size_t &offset, ipc::value &value);
+} // namespace batch
+} // namespace osn
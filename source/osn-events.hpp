@@ -0,0 +1,52 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+
+// Events pushed by the server over the "EventChannel" collection. Every event
+// is sent as its type and value count followed by the values listed below.
+namespace osn {
+enum class EventType : uint32_t {
+	// String outputType, UInt64 uid, String signal, Int32 code, String error
+	OutputSignal = 0,
+	// String outputType, String signal, Int32 code, String error, Int32 service
+	ServiceSignal = 1,
+	// UInt64 source, String name, UInt32 width, UInt32 height, UInt32 flags
+	SourceSize = 2,
+	// UInt64 meter, String sourceName, Int32 channels, then magnitude, peak
+	// and input peak (Float) for each channel
+	Volmeter = 3,
+	// UInt64 source, UInt64 version, UInt32 SourceInvalidation flags
+	SourceInvalidated = 4,
+
+	Count
+};
+
+// What changed on a source since the version sent with SourceInvalidated.
+enum SourceInvalidation : uint32_t {
+	SourceSettings = 1 << 0,
+	SourceProperties = 1 << 1,
+	SourceFilters = 1 << 2,
+};
+
+inline uint32_t EventMask(EventType type)
+{
+	return 1u << uint32_t(type);
+}
+} // namespace osn
@@ -0,0 +1,124 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <cstring>
+#include <vector>
+
+// Wire formats of Scene.GetItemsSnapshot and Scene.ApplyTransforms: a UInt32
+// record count followed by the records. Both processes run on the same
+// machine so the records are copied as they are laid out in memory.
+namespace osn {
+struct SceneItemSnapshot {
+	uint64_t item;
+	uint64_t source;
+	int64_t obs_id;
+
+	float pos_x;
+	float pos_y;
+	float scale_x;
+	float scale_y;
+	float rotation;
+
+	int32_t crop_left;
+	int32_t crop_top;
+	int32_t crop_right;
+	int32_t crop_bottom;
+
+	uint32_t scale_filter;
+	uint32_t blending_mode;
+	uint32_t blending_method;
+
+	uint8_t visible;
+	uint8_t selected;
+	uint8_t stream_visible;
+	uint8_t recording_visible;
+	uint32_t reserved;
+};
+static_assert(sizeof(SceneItemSnapshot) == 80, "SceneItemSnapshot layout changed");
+
+enum SceneItemTransformField : uint32_t {
+	TransformPosition = 1 << 0,
+	TransformScale = 1 << 1,
+	TransformRotation = 1 << 2,
+	TransformCrop = 1 << 3,
+};
+
+// One entry of Scene.ApplyTransforms, only the fields set in mask are applied.
+struct SceneItemTransform {
+	uint64_t item;
+	uint32_t mask;
+
+	float pos_x;
+	float pos_y;
+	float scale_x;
+	float scale_y;
+	float rotation;
+
+	int32_t crop_left;
+	int32_t crop_top;
+	int32_t crop_right;
+	int32_t crop_bottom;
+};
+static_assert(sizeof(SceneItemTransform) == 48, "SceneItemTransform layout changed");
+
+template<typename T> inline void write_scene_records(const std::vector<T> &items, std::vector<char> &buf)
+{
+	uint32_t count = uint32_t(items.size());
+	buf.resize(sizeof(count) + items.size() * sizeof(T));
+	std::memcpy(buf.data(), &count, sizeof(count));
+	if (count)
+		std::memcpy(buf.data() + sizeof(count), items.data(), items.size() * sizeof(T));
+}
+
+template<typename T> inline bool read_scene_records(const std::vector<char> &buf, std::vector<T> &items)
+{
+	uint32_t count = 0;
+	if (buf.size() < sizeof(count))
+		return false;
+	std::memcpy(&count, buf.data(), sizeof(count));
+	if (buf.size() != sizeof(count) + size_t(count) * sizeof(T))
+		return false;
+
+	items.resize(count);
+	if (count)
+		std::memcpy(items.data(), buf.data() + sizeof(count), size_t(count) * sizeof(T));
+	return true;
+}
+
+inline void write_scene_snapshot(const std::vector<SceneItemSnapshot> &items, std::vector<char> &buf)
+{
+	write_scene_records(items, buf);
+}
+
+inline bool read_scene_snapshot(const std::vector<char> &buf, std::vector<SceneItemSnapshot> &items)
+{
+	return read_scene_records(buf, items);
+}
+
+inline void write_scene_transforms(const std::vector<SceneItemTransform> &items, std::vector<char> &buf)
+{
+	write_scene_records(items, buf);
+}
+
+inline bool read_scene_transforms(const std::vector<char> &buf, std::vector<SceneItemTransform> &items)
+{
+	return read_scene_records(buf, items);
+}
+} // namespace osn
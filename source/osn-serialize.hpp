@@ -0,0 +1,83 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstring>
+#include <inttypes.h>
+#include <string>
+#include <vector>
+
+// Little helpers for the binary formats shared by the client and the server,
+// like batches and call traces. Readers return false instead of reading past
+// the end of the buffer.
+namespace osn {
+namespace serialize {
+template<typename T> inline void write_pod(std::vector<char> &buf, const T &value)
+{
+	size_t offset = buf.size();
+	buf.resize(offset + sizeof(T));
+	std::memcpy(&buf[offset], &value, sizeof(T));
+}
+
+template<typename T> inline bool read_pod(const std::vector<char> &buf, size_t &offset, T &value)
+{
+	if (buf.size() < offset + sizeof(T))
+		return false;
+	std::memcpy(&value, &buf[offset], sizeof(T));
+	offset += sizeof(T);
+	return true;
+}
+
+// Counts are read before allocating what they count, so they are rejected
+// when the bytes left cannot hold as many items of at least 'min_size' bytes.
+inline bool read_count(const std::vector<char> &buf, size_t &offset, uint32_t &count, size_t min_size)
+{
+	return read_pod(buf, offset, count) && count <= (buf.size() - offset) / min_size;
+}
+
+inline void write_bytes(std::vector<char> &buf, const char *data, size_t length)
+{
+	write_pod(buf, uint32_t(length));
+	if (!length)
+		return;
+	size_t offset = buf.size();
+	buf.resize(offset + length);
+	std::memcpy(&buf[offset], data, length);
+}
+
+inline bool read_string(const std::vector<char> &buf, size_t &offset, std::string &value)
+{
+	uint32_t length = 0;
+	if (!read_pod(buf, offset, length) || buf.size() < offset + length)
+		return false;
+	value.assign(length ? &buf[offset] : "", length);
+	offset += length;
+	return true;
+}
+
+inline bool read_binary(const std::vector<char> &buf, size_t &offset, std::vector<char> &value)
+{
+	uint32_t length = 0;
+	if (!read_pod(buf, offset, length) || buf.size() < offset + length)
+		return false;
+	value.assign(buf.begin() + offset, buf.begin() + offset + length);
+	offset += length;
+	return true;
+}
+} // namespace serialize
+} // namespace osn
@@ -0,0 +1,88 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-trace.hpp"
+#include <cstring>
+#include "osn-batch.hpp"
+#include "osn-serialize.hpp"
+
+using namespace osn::serialize;
+
+static inline void write_values(std::vector<char> &buf, const std::vector<ipc::value> &values)
+{
+	write_pod(buf, uint32_t(values.size()));
+	for (auto &value : values)
+		osn::batch::write_value(buf, value);
+}
+
+static inline bool read_values(const std::vector<char> &buf, size_t &offset, std::vector<ipc::value> &values)
+{
+	// Every value takes at least its type byte.
+	uint32_t count = 0;
+	if (!read_count(buf, offset, count, 1))
+		return false;
+
+	values.resize(count);
+	for (auto &value : values) {
+		if (!osn::batch::read_value(buf, offset, value))
+			return false;
+	}
+	return true;
+}
+
+void osn::trace::write_header(std::vector<char> &buf)
+{
+	buf.insert(buf.end(), magic, magic + sizeof(magic));
+	write_pod(buf, version);
+}
+
+bool osn::trace::read_header(const std::vector<char> &buf, size_t &offset)
+{
+	if (buf.size() < offset + sizeof(magic) || std::memcmp(&buf[offset], magic, sizeof(magic)) != 0)
+		return false;
+	offset += sizeof(magic);
+
+	uint32_t file_version = 0;
+	return read_pod(buf, offset, file_version) && file_version == version;
+}
+
+void osn::trace::write_record(std::vector<char> &buf, const Record &record)
+{
+	write_pod(buf, record.timestamp);
+	write_pod(buf, record.duration);
+	write_pod(buf, record.flags);
+	osn::batch::write_value(buf, ipc::value(record.collection));
+	osn::batch::write_value(buf, ipc::value(record.function));
+	write_values(buf, record.args);
+	write_values(buf, record.reply);
+}
+
+bool osn::trace::read_record(const std::vector<char> &buf, size_t &offset, Record &record)
+{
+	ipc::value collection, function;
+	if (!read_pod(buf, offset, record.timestamp) || !read_pod(buf, offset, record.duration) || !read_pod(buf, offset, record.flags))
+		return false;
+	if (!osn::batch::read_value(buf, offset, collection) || !osn::batch::read_value(buf, offset, function))
+		return false;
+	if (collection.type != ipc::type::String || function.type != ipc::type::String)
+		return false;
+
+	record.collection = collection.value_str;
+	record.function = function.value_str;
+	return read_values(buf, offset, record.args) && read_values(buf, offset, record.reply);
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <string>
+#include <vector>
+#include "ipc-value.hpp"
+
+// File format of the IPC traces recorded by the client and read back by the
+// replay tool (tools/benchmarks/ipc-replay.cpp). A trace is a header followed
+// by one record per call, in the order the calls were made. Values use the
+// "Batch" wire format.
+namespace osn {
+namespace trace {
+// "OSNTRACE" followed by the format version.
+static const char magic[8] = {'O', 'S', 'N', 'T', 'R', 'A', 'C', 'E'};
+static const uint32_t version = 1;
+
+enum RecordFlags : uint8_t {
+	// Made with ipc::client::call, the client did not wait for the reply and
+	// the record has none.
+	RecordAsync = 1,
+};
+
+struct Record {
+	// Microseconds since the start of the recording, when the call was made.
+	uint64_t timestamp = 0;
+	// Microseconds until the reply was received, 0 for async calls.
+	uint64_t duration = 0;
+	uint8_t flags = 0;
+	std::string collection;
+	std::string function;
+	std::vector<ipc::value> args;
+	std::vector<ipc::value> reply;
+};
+
+void write_header(std::vector<char> &buf);
+bool read_header(const std::vector<char> &buf, size_t &offset);
+
+void write_record(std::vector<char> &buf, const Record &record);
+bool read_record(const std::vector<char> &buf, size_t &offset, Record &record);
+} // namespace trace
+} // namespace osn
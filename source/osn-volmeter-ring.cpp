@@ -0,0 +1,187 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-volmeter-ring.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static constexpr uint32_t RING_MAGIC = 0x4f534e56; // OSNV
+static constexpr uint32_t RING_VERSION = 2;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The ring requires address-free 64 bits atomics.");
+
+osn::VolmeterRing::~VolmeterRing()
+{
+	Close();
+}
+
+size_t osn::VolmeterRing::GetSize()
+{
+	return sizeof(Header) + sizeof(VolmeterFrame) * CAPACITY;
+}
+
+bool osn::VolmeterRing::Create(const std::string &name)
+{
+	Close();
+	this->name = name;
+	owner = true;
+	if (!Map(true))
+		return false;
+
+	header->magic = RING_MAGIC;
+	header->version = RING_VERSION;
+	header->capacity = CAPACITY;
+	header->frameSize = sizeof(VolmeterFrame);
+	header->head.store(0, std::memory_order_relaxed);
+	header->tail.store(0, std::memory_order_relaxed);
+	return true;
+}
+
+bool osn::VolmeterRing::Open(const std::string &name)
+{
+	Close();
+	this->name = name;
+	owner = false;
+	if (!Map(false))
+		return false;
+
+	if (header->magic != RING_MAGIC || header->version != RING_VERSION || header->capacity != CAPACITY ||
+	    header->frameSize != sizeof(VolmeterFrame)) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+bool osn::VolmeterRing::Map(bool create)
+{
+	size_t size = GetSize();
+	void *memory = nullptr;
+
+#ifdef WIN32
+	if (create) {
+		mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, DWORD(size), name.c_str());
+	} else {
+		mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+	}
+	if (!mapping)
+		return false;
+
+	memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+	if (!memory) {
+		Close();
+		return false;
+	}
+#else
+	if (create) {
+		// Left over by a server that did not exit cleanly.
+		shm_unlink(name.c_str());
+		fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+		if (fd != -1 && ftruncate(fd, size) != 0) {
+			Close();
+			return false;
+		}
+	} else {
+		fd = shm_open(name.c_str(), O_RDWR, 0600);
+	}
+	if (fd == -1)
+		return false;
+
+	memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (memory == MAP_FAILED) {
+		Close();
+		return false;
+	}
+#endif
+
+	header = create ? new (memory) Header() : reinterpret_cast<Header *>(memory);
+	frames = reinterpret_cast<VolmeterFrame *>(reinterpret_cast<char *>(memory) + sizeof(Header));
+	return true;
+}
+
+void osn::VolmeterRing::Close()
+{
+#ifdef WIN32
+	if (header)
+		UnmapViewOfFile(header);
+	if (mapping)
+		CloseHandle(mapping);
+	mapping = nullptr;
+#else
+	if (header)
+		munmap(header, GetSize());
+	if (fd != -1) {
+		::close(fd);
+		if (owner)
+			shm_unlink(name.c_str());
+	}
+	fd = -1;
+#endif
+	header = nullptr;
+	frames = nullptr;
+}
+
+bool osn::VolmeterRing::IsOpen() const
+{
+	return header != nullptr;
+}
+
+bool osn::VolmeterRing::Push(const VolmeterFrame &frame)
+{
+	if (!header)
+		return false;
+
+	uint64_t head = header->head.load(std::memory_order_relaxed);
+	uint64_t tail = header->tail.load(std::memory_order_acquire);
+	if (head - tail >= CAPACITY)
+		return false;
+
+	std::memcpy(&frames[head % CAPACITY], &frame, sizeof(VolmeterFrame));
+	header->head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+const osn::VolmeterFrame *osn::VolmeterRing::Peek(size_t &count) const
+{
+	count = 0;
+	if (!header)
+		return nullptr;
+
+	uint64_t tail = header->tail.load(std::memory_order_relaxed);
+	uint64_t head = header->head.load(std::memory_order_acquire);
+	count = size_t(std::min<uint64_t>(head - tail, CAPACITY - tail % CAPACITY));
+	return &frames[tail % CAPACITY];
+}
+
+void osn::VolmeterRing::Consume(size_t count)
+{
+	if (!header)
+		return;
+
+	uint64_t tail = header->tail.load(std::memory_order_relaxed);
+	header->tail.store(tail + count, std::memory_order_release);
+}
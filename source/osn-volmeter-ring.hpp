@@ -0,0 +1,102 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <inttypes.h>
+#include <string>
+
+namespace osn {
+static constexpr uint32_t VOLMETER_MAX_CHANNELS = 8;
+
+// Every field is 32 bits wide so that JS can read a frame through a
+// Uint32Array and a Float32Array over the same memory. Meter ids do not fit
+// in a float, they are split in two lanes.
+struct VolmeterFrame {
+	uint32_t meter_lo;
+	uint32_t meter_hi;
+	uint32_t channels;
+	uint32_t reserved;
+	float magnitude[VOLMETER_MAX_CHANNELS];
+	float peak[VOLMETER_MAX_CHANNELS];
+	float input_peak[VOLMETER_MAX_CHANNELS];
+};
+
+// Layout of a frame in 32 bits words: meter low, meter high, channels,
+// reserved, magnitude[8], peak[8], input peak[8].
+static constexpr uint32_t VOLMETER_FRAME_WORDS = 4 + VOLMETER_MAX_CHANNELS * 3;
+static_assert(sizeof(VolmeterFrame) == VOLMETER_FRAME_WORDS * 4, "Volmeter frames must be packed 32 bits words.");
+
+// Single-producer/single-consumer ring of volmeter frames in shared memory.
+// The server writes the frames from its volmeter publisher thread and the
+// client reads them directly, volmeter data never goes through the IPC
+// socket. Head and tail are free running counters: the ring is empty when
+// they are equal and full when they are CAPACITY apart. A full ring drops new
+// frames until the reader catches up.
+class VolmeterRing {
+public:
+	static constexpr uint32_t CAPACITY = 1024;
+
+	VolmeterRing(){};
+	~VolmeterRing();
+
+	VolmeterRing(VolmeterRing const &) = delete;
+	void operator=(VolmeterRing const &) = delete;
+
+public:
+	// Server side, creates the shared memory.
+	bool Create(const std::string &name);
+	// Client side, maps the shared memory created by the server.
+	bool Open(const std::string &name);
+	void Close();
+	bool IsOpen() const;
+
+	bool Push(const VolmeterFrame &frame);
+
+	// Readable frames from the tail up to the end of the ring memory, so that
+	// the reader can use them in place. They are not overwritten until they
+	// are released with Consume.
+	const VolmeterFrame *Peek(size_t &count) const;
+	void Consume(size_t count);
+
+private:
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t capacity;
+		uint32_t frameSize;
+		// Written by the producer only.
+		alignas(64) std::atomic<uint64_t> head;
+		// Written by the consumer only.
+		alignas(64) std::atomic<uint64_t> tail;
+	};
+
+	static size_t GetSize();
+	bool Map(bool create);
+
+	std::string name;
+	bool owner = false;
+	Header *header = nullptr;
+	VolmeterFrame *frames = nullptr;
+#ifdef WIN32
+	void *mapping = nullptr;
+#else
+	int fd = -1;
+#endif
+};
+} // namespace osn
@@ -4,6 +4,10 @@ import * as osn from '../osn';
 import { logInfo, logEmptyLine } from '../util/logger';
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
 import { OBSHandler, IPerformanceState, TOBSHotkey } from '../util/obs_handler';
+import { EOBSInputTypes } from '../util/obs_enums';
+import * as path from 'path';
+import * as fs from 'fs';
+import * as os from 'os';
 import { showHideInputHotkeys, slideshowHotkeys, ffmpeg_sourceHotkeys,
     game_captureHotkeys, dshow_wasapitHotkeys,coreaudioHotkeys,  deleteConfigFiles } from '../util/general';
 
@@ -178,6 +182,172 @@ describe(testName, function() {
             to.equal('High', 'Invalid process priority value');
     });
 
+    it('Get cache statistics and bound a cache', function() {
+        const sceneName = 'cache_test_scene';
+        const scene = osn.SceneFactory.create(sceneName);
+        expect(osn.SceneFactory.fromName(sceneName)).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.SceneFromName, sceneName));
+
+        const stats = osn.NodeObs.GetCacheStatistics();
+        expect(stats.scenes.hits).to.be.greaterThan(0, 'Scene cache lookups were not counted');
+        expect(stats.scenes.size).to.be.greaterThan(0, 'Scene was not cached');
+
+        osn.NodeObs.SetCacheCapacity('sceneItems', 1000);
+        expect(osn.NodeObs.GetCacheStatistics().sceneItems.capacity).to.equal(1000, 'Invalid scene item cache capacity');
+        osn.NodeObs.SetCacheCapacity('sceneItems', 0);
+
+        scene.release();
+    });
+
+    it('Coalesce setters while enabled', function() {
+        const input = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'coalesced_input');
+        const fader = osn.FaderFactory.create(osn.EFaderType.IEC);
+        fader.attach(input);
+
+        osn.NodeObs.SetSetterCoalescing(true);
+        expect(osn.NodeObs.GetSetterCoalescing()).to.equal(true, 'Setter coalescing was not enabled');
+
+        [0.1, 0.2, 0.3, 0.4, 0.5].forEach(function(deflection) {
+            fader.deflection = deflection;
+        });
+
+        // Disabling applies the last pending value
+        osn.NodeObs.SetSetterCoalescing(false);
+        expect(osn.NodeObs.GetSetterCoalescing()).to.equal(false, 'Setter coalescing was not disabled');
+        expect(fader.deflection).to.be.closeTo(0.5, 0.01, 'Last coalesced value was not applied');
+
+        fader.detach();
+        input.release();
+    });
+
+    it('Profile server calls while enabled', function() {
+        osn.NodeObs.ResetServerProfile();
+        osn.NodeObs.SetServerProfiling(true);
+
+        const input = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'profiled_input');
+        for (let i = 0; i < 5; i++) {
+            input.volume;
+        }
+        input.release();
+
+        osn.NodeObs.SetServerProfiling(false);
+        const profile = osn.NodeObs.GetServerProfile();
+        const volume = profile.find((entry: any) => entry.name == 'Input::GetVolume');
+        expect(volume).to.not.equal(undefined, 'Input::GetVolume was not profiled');
+        expect(volume.calls).to.be.at.least(1, 'Input::GetVolume call count is missing');
+        expect(volume.p50Us).to.be.at.most(volume.maxUs, 'Input::GetVolume latency histogram is inconsistent');
+        expect(volume.replyBytes).to.be.greaterThan(0, 'Input::GetVolume reply size is missing');
+        osn.NodeObs.ResetServerProfile();
+    });
+
+    it('Report the media cache state', function() {
+        const input = osn.InputFactory.create(EOBSInputTypes.FFMPEGSource, 'cached_media_input');
+
+        const state = osn.NodeObs.GetMediaCacheState();
+        expect(state.allowedBytes).to.be.at.most(2004800000, 'Media cache budget exceeds its limit');
+        expect(state.cachedBytes).to.be.at.least(0, 'Invalid cached size');
+        const media = state.sources.find((entry: any) => entry.name == 'cached_media_input');
+        expect(media).to.not.equal(undefined, 'Media source is not tracked by the memory manager');
+        expect(media.cached).to.equal(false, 'Media source without a file was cached');
+
+        input.release();
+    });
+
+    it('Configure the log rate limit', function() {
+        const defaults = osn.NodeObs.GetLogRateLimit();
+        expect(defaults.burst).to.be.greaterThan(0, 'Log rate limit is disabled by default');
+
+        osn.NodeObs.SetLogRateLimit(5000, 3);
+        const limit = osn.NodeObs.GetLogRateLimit();
+        expect(limit.windowMs).to.equal(5000, 'Log rate limit window was not set');
+        expect(limit.burst).to.equal(3, 'Log rate limit burst was not set');
+        expect(limit.suppressed).to.be.at.least(0, 'Invalid suppressed line count');
+
+        osn.NodeObs.SetLogRateLimit(defaults.windowMs, defaults.burst);
+    });
+
+    it('Keep distinct log lines sharing a format', async function() {
+        const defaults = osn.NodeObs.GetLogRateLimit();
+        osn.NodeObs.SetLogRateLimit(5000, 3);
+        const before = osn.NodeObs.GetLogRateLimit().suppressed;
+
+        // Every release logs "Releasing scene <name>" from the same format
+        const sceneNames: string[] = [];
+        for (let i = 0; i < 10; i++) {
+            const sceneName = 'log_limiter_scene_' + i;
+            const scene = osn.SceneFactory.create(sceneName);
+            expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateScene, sceneName));
+            scene.release();
+            sceneNames.push(sceneName);
+        }
+
+        expect(osn.NodeObs.GetLogRateLimit().suppressed).to.equal(before, 'Distinct log lines were dropped');
+
+        // Lines reach the report once the log writer drained them
+        await new Promise(resolve => setTimeout(resolve, 500));
+        const messages = osn.NodeObs.GetLogReport('general').entries.map((entry: any) => entry.message);
+        sceneNames.forEach(function(sceneName) {
+            expect(messages.some((message: string) => message.includes('Releasing scene ' + sceneName))).to.equal(true, 'Log line of ' + sceneName + ' is missing');
+        });
+
+        osn.NodeObs.SetLogRateLimit(defaults.windowMs, defaults.burst);
+    });
+
+    it('Query the log report', function() {
+        const report = osn.NodeObs.GetLogReport('general', 0, 10);
+        expect(report.entries.length).to.be.at.most(10, 'Log report returned too many entries');
+        expect(report.total).to.be.at.least(report.entries.length, 'Log report count is inconsistent');
+        for (let i = 1; i < report.entries.length; i++) {
+            expect(report.entries[i].sequence).to.be.greaterThan(report.entries[i - 1].sequence, 'Log report entries are out of order');
+        }
+
+        const newer = osn.NodeObs.GetLogReport('general', report.lastSequence);
+        newer.entries.forEach(function(entry: any) {
+            expect(entry.sequence).to.be.greaterThan(report.lastSequence, 'Log report returned older entries');
+        });
+
+        expect(function() {
+            osn.NodeObs.GetLogReport('verbose');
+        }).to.throw();
+    });
+
+    it('Time client calls while enabled', async function() {
+        osn.NodeObs.ResetClientProfile();
+        osn.NodeObs.SetClientProfiling(true);
+
+        const input = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'timed_input');
+        input.volume;
+        await input.getPropertiesAsync();
+        input.release();
+
+        osn.NodeObs.SetClientProfiling(false);
+        const profile = osn.NodeObs.GetClientProfile();
+        const volume = profile.find((entry: any) => entry.name == 'Input::GetVolume');
+        expect(volume).to.not.equal(undefined, 'Input::GetVolume was not timed');
+        expect(volume.calls).to.equal(1, 'Input::GetVolume call count is wrong');
+        expect(volume.waitUs).to.be.at.most(volume.wallUs, 'Input::GetVolume wait exceeds its wall time');
+
+        const properties = profile.find((entry: any) => entry.name == 'Source::GetProperties');
+        expect(properties).to.not.equal(undefined, 'Async Source::GetProperties was not timed');
+        expect(properties.queueUs + properties.waitUs + properties.convertUs).to.be.at.most(properties.wallUs + 3,
+            'Async Source::GetProperties times exceed its wall time');
+        osn.NodeObs.ResetClientProfile();
+    });
+
+    it('Record server calls to a trace file', function() {
+        const tracePath = path.join(os.tmpdir(), 'osn-call-trace.bin');
+        expect(osn.NodeObs.StartCallTrace(tracePath)).to.equal(true, 'Call trace could not be started');
+
+        const input = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'traced_input');
+        input.volume;
+        input.release();
+        osn.NodeObs.StopCallTrace();
+
+        const trace = fs.readFileSync(tracePath);
+        expect(trace.toString('latin1', 0, 8)).to.equal('OSNTRACE', 'Call trace header is missing');
+        expect(trace.includes('GetVolume')).to.equal(true, 'Input::GetVolume was not recorded');
+        fs.unlinkSync(tracePath);
+    });
+
     it('Stop crash handler', function() {
         // Stopping crash handler as a last test case
         expect(function() {
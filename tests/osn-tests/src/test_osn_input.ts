@@ -259,6 +259,21 @@ describe(testName, () => {
         });
     });
 
+    it('Create an input and get its properties asynchronously', async () => {
+        const input = await osn.InputFactory.createAsync(EOBSInputTypes.ImageSource, 'async_input');
+
+        // Checking if input source was created correctly
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ImageSource));
+        expect(input.id).to.equal(EOBSInputTypes.ImageSource, GetErrorMessage(ETestErrorMsg.InputId, EOBSInputTypes.ImageSource));
+        expect(input.name).to.equal('async_input', GetErrorMessage(ETestErrorMsg.InputName, EOBSInputTypes.ImageSource));
+
+        // Checking that both property getters agree
+        const properties = await input.getPropertiesAsync();
+        expect(properties).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.Properties, EOBSInputTypes.ImageSource));
+        expect(properties.first().name).to.equal(input.properties.first().name, GetErrorMessage(ETestErrorMsg.Properties, EOBSInputTypes.ImageSource));
+        input.release();
+    });
+
     it('Get volume value from input source', () => {
         let volume: number = undefined;
 
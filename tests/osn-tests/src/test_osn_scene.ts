@@ -295,6 +295,56 @@ describe(testName, () => {
         scene.release();
     });
 
+    it('Apply transforms to several scene items', () => {
+        const sceneName = 'applyTransforms_test_scene';
+
+        // Creating scene
+        const scene = osn.SceneFactory.create(sceneName);
+
+        // Checking if scene was created correctly
+        expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateScene, sceneName));
+
+        // Adding two input sources to the scene
+        const firstInput = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'transform_input_1');
+        const secondInput = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'transform_input_2');
+        const firstSceneItem = scene.add(firstInput);
+        const secondSceneItem = scene.add(secondInput);
+
+        // Moving both items and cropping the second one in a single call
+        scene.applyTransforms([
+            {item: firstSceneItem, position: {x: 100, y: 200}, rotation: 90},
+            {item: secondSceneItem, scale: {x: 2, y: 3}, crop: {left: 1, top: 2, right: 3, bottom: 4}},
+        ]);
+
+        // Checking the values seen through freshly fetched items
+        const sceneItems = scene.getItems();
+        expect(sceneItems.length).to.equal(2, GetErrorMessage(ETestErrorMsg.GetSceneItems, sceneName));
+        expect(sceneItems[0].position.x).to.equal(100, GetErrorMessage(ETestErrorMsg.PositionX));
+        expect(sceneItems[0].position.y).to.equal(200, GetErrorMessage(ETestErrorMsg.PositionY));
+        expect(sceneItems[0].rotation).to.equal(90, GetErrorMessage(ETestErrorMsg.Rotation));
+        expect(sceneItems[1].scale.x).to.equal(2, GetErrorMessage(ETestErrorMsg.ScaleX));
+        expect(sceneItems[1].scale.y).to.equal(3, GetErrorMessage(ETestErrorMsg.ScaleY));
+        expect(sceneItems[1].crop.left).to.equal(1, GetErrorMessage(ETestErrorMsg.CropLeft));
+        expect(sceneItems[1].crop.top).to.equal(2, GetErrorMessage(ETestErrorMsg.CropTop));
+        expect(sceneItems[1].crop.right).to.equal(3, GetErrorMessage(ETestErrorMsg.CropRight));
+        expect(sceneItems[1].crop.bottom).to.equal(4, GetErrorMessage(ETestErrorMsg.CropBottom));
+
+        // Checking the values stored on the server, transformInfo is always fetched and never read from the cache
+        const firstTransform = firstSceneItem.transformInfo;
+        expect(firstTransform.pos.x).to.equal(100, GetErrorMessage(ETestErrorMsg.PositionX));
+        expect(firstTransform.pos.y).to.equal(200, GetErrorMessage(ETestErrorMsg.PositionY));
+        expect(firstTransform.rot).to.equal(90, GetErrorMessage(ETestErrorMsg.Rotation));
+        const secondTransform = secondSceneItem.transformInfo;
+        expect(secondTransform.scale.x).to.equal(2, GetErrorMessage(ETestErrorMsg.ScaleX));
+        expect(secondTransform.scale.y).to.equal(3, GetErrorMessage(ETestErrorMsg.ScaleY));
+
+        firstSceneItem.source.release();
+        firstSceneItem.remove();
+        secondSceneItem.source.release();
+        secondSceneItem.remove();
+        scene.release();
+    });
+
     it('Fail test - Get scene from name that don\'t exist ', () => {
         expect(function() {
             const failSceneFromName = osn.SceneFactory.fromName('does_not_exist');
@@ -399,4 +399,35 @@ describe(testName, () => {
         sceneItem.source.release();
         sceneItem.remove();
     });
+
+    it('Read several scene items in a single batched call', () => {
+        // Getting scene
+        const scene = osn.SceneFactory.fromName(sceneName);
+
+        // Getting source
+        const source = osn.InputFactory.fromName(sourceName);
+
+        // Adding input source to scene twice to create two scene items
+        const firstItem = scene.add(source);
+        const secondItem = scene.add(source);
+        firstItem.position = {x: 10, y: 20};
+        secondItem.position = {x: 30, y: 40};
+
+        // Reading both positions and an invalid call in one round-trip
+        const results = osn.IPC.batch([
+            { collection: 'SceneItem', func: 'GetPosition', args: [{ type: 'reference', value: firstItem }] },
+            { collection: 'SceneItem', func: 'GetPosition', args: [{ type: 'reference', value: secondItem }] },
+            { collection: 'SceneItem', func: 'DoesNotExist', args: [] },
+        ]);
+
+        // Checking replies are returned in order, error code first
+        expect(results.length).to.equal(3, GetErrorMessage(ETestErrorMsg.BatchResultCount));
+        expect(results[0]).to.eql([0, 10, 20], GetErrorMessage(ETestErrorMsg.BatchResult, '0'));
+        expect(results[1]).to.eql([0, 30, 40], GetErrorMessage(ETestErrorMsg.BatchResult, '1'));
+        expect(results[2]).to.be.an.instanceof(Error, GetErrorMessage(ETestErrorMsg.BatchResult, '2'));
+
+        firstItem.source.release();
+        firstItem.remove();
+        secondItem.remove();
+    });
 });
@@ -79,4 +79,50 @@ describe(testName, () => {
 
         input.release();
     });
+
+    it('Register and remove the shared volmeter buffer callback', () => {
+        const input = osn.InputFactory.create(EOBSInputTypes.WASAPIInput, 'input');
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.WASAPIInput));
+
+        const volmeter = osn.VolmeterFactory.create(osn.EFaderType.IEC);
+        expect(volmeter).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateVolmeter));
+        expect(volmeter.id).to.be.a('number', GetErrorMessage(ETestErrorMsg.VolmeterId));
+
+        expect(function() {
+            osn.NodeObs.RegisterVolmeterBufferCallback((levels: Float32Array, words: Uint32Array) => {});
+            volmeter.attach(input);
+        }).to.not.throw();
+
+        expect(function() {
+            volmeter.detach();
+            osn.NodeObs.RemoveVolmeterBufferCallback();
+        }).to.not.throw();
+
+        input.release();
+    });
+
+    it('Keep full volmeter ids after a slot is reused', () => {
+        const first = osn.VolmeterFactory.create(osn.EFaderType.IEC);
+        expect(first).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateVolmeter));
+        const firstId = first.id;
+        first.destroy();
+
+        // The freed slot comes back with a bumped generation in the upper 32 bits
+        const second = osn.VolmeterFactory.create(osn.EFaderType.IEC);
+        expect(second).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateVolmeter));
+        expect(Number.isSafeInteger(second.id)).to.equal(true, GetErrorMessage(ETestErrorMsg.VolmeterIdReuse));
+        expect(second.id).to.be.at.least(2 ** 32, GetErrorMessage(ETestErrorMsg.VolmeterIdReuse));
+        expect(second.id).to.not.equal(firstId, GetErrorMessage(ETestErrorMsg.VolmeterIdReuse));
+
+        const input = osn.InputFactory.create(EOBSInputTypes.WASAPIInput, 'input');
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.WASAPIInput));
+
+        expect(function() {
+            second.attach(input);
+            second.detach();
+        }).to.not.throw();
+
+        second.destroy();
+        input.release();
+    });
 });
@@ -126,6 +126,8 @@ export const enum ETestErrorMsg {
     Selected = 'Failed to set selected attribute of scene item',
     PositionX = 'Failed to set position x attribute of scene item',
     PositionY = 'Failed to set position y attribute of scene item',
+    BatchResultCount = 'Batched call returned the wrong number of results',
+    BatchResult = 'Batched call %VALUE1% returned the wrong result',
     Rotation = 'Failed to set rotation attribute of scene item',
     ScaleX = 'Failed to set scale x attribute of scene item',
     ScaleY = 'Failed to set scale y attribute of scene item',
@@ -189,6 +191,8 @@ export const enum ETestErrorMsg {
     CreateVolmeter = 'Failed to create volmeter',
     VolmeterCallback = 'Failed to add callback to volmeter',
     RemoveVolmeterCallback = 'Failed to remove callback from volmeter',
+    VolmeterId = 'Volmeter id is not a number',
+    VolmeterIdReuse = 'Volmeter id of a reused slot did not reach the client intact',
     // osn-audio
     AudioDefaultSampleRate = 'The default value of audio sample rate is wrong',
     AudioDefaultSpeakers = 'The default value of audio speakers is wrong',
@@ -0,0 +1,284 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Replays an IPC trace recorded by the client (OSN_IPC_TRACE or
+// StartCallTrace) against a server, and reports the latency of every
+// collection::function and the overall throughput. Calls are sent back to
+// back, or with their recorded timing with --realtime.
+//
+// Object ids returned by the server are not guaranteed to be the same from a
+// session to another, so ids read from the recorded replies are mapped to the
+// ones of the replay and substituted in later arguments (--no-remap disables
+// it). The "diff" column counts the calls whose error code differs from the
+// recording, a sign that the replay diverged from the session.
+//
+// Only calls made by bindings through GetConnection(info), and the async
+// ones, are recorded. Code calling Controller::GetConnection() directly, such
+// as the event channel, autoconfig or signal polling, bypasses the trace and
+// is not replayed.
+//
+// Usage: ipc-replay <trace> --connect <socket>
+//        ipc-replay <trace> --server <obs64 path> --version <version>
+//        [--realtime] [--no-remap]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <ipc-client.hpp>
+#include "osn-error.hpp"
+#include "osn-trace.hpp"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <spawn.h>
+extern char **environ;
+#endif
+
+struct FunctionLatency {
+	std::vector<uint64_t> samples;
+	uint64_t total_us = 0;
+	uint64_t recorded_us = 0;
+	uint64_t async_calls = 0;
+	uint64_t mismatches = 0;
+};
+
+static bool LoadTrace(const std::string &path, std::vector<osn::trace::Record> &records)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	std::vector<char> buf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	size_t offset = 0;
+	if (!osn::trace::read_header(buf, offset))
+		return false;
+
+	// A trace cut short by a crash keeps the records before the last one.
+	while (offset < buf.size()) {
+		osn::trace::Record record;
+		if (!osn::trace::read_record(buf, offset, record))
+			break;
+		records.push_back(std::move(record));
+	}
+	return true;
+}
+
+static bool SpawnServer(const std::string &binary, const std::string &socket, const std::string &version)
+{
+#ifdef WIN32
+	std::string commandLine = "\"" + binary + "\" " + socket + " " + version;
+	STARTUPINFOA si = {sizeof(si)};
+	PROCESS_INFORMATION pi = {};
+	if (!CreateProcessA(binary.c_str(), &commandLine[0], nullptr, nullptr, FALSE, 0, nullptr, nullptr, &si, &pi))
+		return false;
+	CloseHandle(pi.hThread);
+	CloseHandle(pi.hProcess);
+	return true;
+#else
+	std::vector<char> socket_str(socket.c_str(), socket.c_str() + socket.size() + 1);
+	std::vector<char> version_str(version.c_str(), version.c_str() + version.size() + 1);
+	std::vector<char> binary_str(binary.c_str(), binary.c_str() + binary.size() + 1);
+	char name[] = "obs64";
+	char *argv[] = {name, socket_str.data(), version_str.data(), binary_str.data(), nullptr};
+	pid_t pid;
+	return posix_spawnp(&pid, binary.c_str(), nullptr, nullptr, argv, environ) == 0;
+#endif
+}
+
+static std::shared_ptr<ipc::client> Connect(const std::string &socket)
+{
+#ifdef WIN32
+	std::string path = socket;
+#else
+	std::string path = "/tmp/" + socket;
+#endif
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+	while (std::chrono::steady_clock::now() < deadline) {
+		try {
+			std::shared_ptr<ipc::client> conn = ipc::client::create(path);
+			if (conn)
+				return conn;
+		} catch (...) {
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+	return nullptr;
+}
+
+static void RemapArguments(std::vector<ipc::value> &args, const std::unordered_map<uint64_t, uint64_t> &ids)
+{
+	for (auto &arg : args) {
+		if (arg.type != ipc::type::UInt64)
+			continue;
+		auto iter = ids.find(arg.value_union.ui64);
+		if (iter != ids.end())
+			arg.value_union.ui64 = iter->second;
+	}
+}
+
+static void LearnIds(const std::vector<ipc::value> &recorded, const std::vector<ipc::value> &replayed, std::unordered_map<uint64_t, uint64_t> &ids)
+{
+	// The error code comes first and is never an id.
+	for (size_t idx = 1; idx < recorded.size() && idx < replayed.size(); idx++) {
+		if (recorded[idx].type != ipc::type::UInt64 || replayed[idx].type != ipc::type::UInt64)
+			continue;
+		if (recorded[idx].value_union.ui64 != replayed[idx].value_union.ui64)
+			ids[recorded[idx].value_union.ui64] = replayed[idx].value_union.ui64;
+	}
+}
+
+static bool SameError(const std::vector<ipc::value> &recorded, const std::vector<ipc::value> &replayed)
+{
+	if (recorded.empty() || replayed.empty())
+		return recorded.empty() == replayed.empty();
+	if (recorded[0].type != replayed[0].type)
+		return false;
+	return recorded[0].type != ipc::type::UInt64 || recorded[0].value_union.ui64 == replayed[0].value_union.ui64;
+}
+
+static uint64_t Percentile(const std::vector<uint64_t> &sorted, double percentile)
+{
+	if (sorted.empty())
+		return 0;
+	size_t idx = size_t(double(sorted.size() - 1) * percentile + 0.5);
+	return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+int main(int argc, char *argv[])
+{
+	std::string trace, socket, server, version;
+	bool realtime = false;
+	bool remap = true;
+	for (int idx = 1; idx < argc; idx++) {
+		std::string arg = argv[idx];
+		if (arg == "--connect" && idx + 1 < argc) {
+			socket = argv[++idx];
+		} else if (arg == "--server" && idx + 1 < argc) {
+			server = argv[++idx];
+		} else if (arg == "--version" && idx + 1 < argc) {
+			version = argv[++idx];
+		} else if (arg == "--realtime") {
+			realtime = true;
+		} else if (arg == "--no-remap") {
+			remap = false;
+		} else if (trace.empty()) {
+			trace = arg;
+		}
+	}
+
+	if (trace.empty() || (socket.empty() && (server.empty() || version.empty()))) {
+		std::fprintf(stderr,
+			     "usage: %s <trace> --connect <socket>\n"
+			     "       %s <trace> --server <obs64 path> --version <version>\n"
+			     "       [--realtime] [--no-remap]\n"
+			     "Calls made through Controller::GetConnection() directly are not in the trace.\n",
+			     argv[0], argv[0]);
+		return 1;
+	}
+
+	std::vector<osn::trace::Record> records;
+	if (!LoadTrace(trace, records)) {
+		std::fprintf(stderr, "failed to read trace %s\n", trace.c_str());
+		return 1;
+	}
+
+	bool owned = socket.empty();
+	if (owned) {
+		socket = "osn-replay-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+		if (!SpawnServer(server, socket, version)) {
+			std::fprintf(stderr, "failed to start %s\n", server.c_str());
+			return 1;
+		}
+	}
+
+	std::shared_ptr<ipc::client> conn = Connect(socket);
+	if (!conn) {
+		std::fprintf(stderr, "failed to connect to %s\n", socket.c_str());
+		return 1;
+	}
+
+	std::map<std::string, FunctionLatency> functions;
+	std::unordered_map<uint64_t, uint64_t> ids;
+	uint64_t recorded_total = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (auto &record : records) {
+		if (realtime)
+			std::this_thread::sleep_until(start + std::chrono::microseconds(record.timestamp));
+		if (remap)
+			RemapArguments(record.args, ids);
+
+		FunctionLatency &latency = functions[record.collection + "::" + record.function];
+		if (record.flags & osn::trace::RecordAsync) {
+			conn->call(record.collection, record.function, record.args);
+			latency.async_calls++;
+			continue;
+		}
+
+		auto call_start = std::chrono::steady_clock::now();
+		std::vector<ipc::value> reply = conn->call_synchronous_helper(record.collection, record.function, record.args);
+		latency.samples.push_back(
+			uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - call_start).count()));
+		latency.recorded_us += record.duration;
+		recorded_total += record.duration;
+		if (!SameError(record.reply, reply))
+			latency.mismatches++;
+		if (remap)
+			LearnIds(record.reply, reply, ids);
+	}
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::vector<std::pair<std::string, FunctionLatency *>> sorted;
+	uint64_t replayed_total = 0;
+	size_t calls = 0;
+	for (auto &function : functions) {
+		std::sort(function.second.samples.begin(), function.second.samples.end());
+		for (auto sample : function.second.samples)
+			function.second.total_us += sample;
+		replayed_total += function.second.total_us;
+		calls += function.second.samples.size() + function.second.async_calls;
+		sorted.push_back({function.first, &function.second});
+	}
+	// The functions the replay spent the most time in come first.
+	std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) { return a.second->total_us > b.second->total_us; });
+
+	std::printf("%-48s %8s %6s %12s %10s %10s %10s %12s %6s\n", "function", "calls", "async", "total us", "p50 us", "p99 us", "max us",
+		    "recorded us", "diff");
+	for (auto &function : sorted) {
+		const FunctionLatency &latency = *function.second;
+		std::printf("%-48s %8zu %6llu %12llu %10llu %10llu %10llu %12llu %6llu\n", function.first.c_str(), latency.samples.size(),
+			    (unsigned long long)latency.async_calls, (unsigned long long)latency.total_us, (unsigned long long)Percentile(latency.samples, 0.5),
+			    (unsigned long long)Percentile(latency.samples, 0.99), (unsigned long long)(latency.samples.empty() ? 0 : latency.samples.back()),
+			    (unsigned long long)latency.recorded_us, (unsigned long long)latency.mismatches);
+	}
+	std::printf("\n%zu calls in %.3fs, %.0f calls/s\n", calls, elapsed, elapsed > 0 ? double(calls) / elapsed : 0.0);
+	std::printf("blocking time: %.3fs replayed, %.3fs recorded\n", double(replayed_total) / 1e6, double(recorded_total) / 1e6);
+
+	if (owned)
+		conn->call_synchronous_helper("System", "Shutdown", {});
+	return 0;
+}
@@ -0,0 +1,196 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Churn benchmark for utility::unique_id. Keeps a fixed number of ids alive
+// and either replaces a random id at a time, or frees a random half of them
+// and allocates them back, like a scene collection being switched. The range
+// list allocator that unique_id used before is kept here for comparison.
+//
+// Usage: unique-id-benchmark [live ids] [iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include <vector>
+#include "unique-id.hpp"
+
+class legacy_unique_id {
+public:
+	typedef uint64_t id_t;
+	typedef std::pair<id_t, id_t> range_t;
+
+	id_t allocate()
+	{
+		if (allocated.size() > 0) {
+			for (auto &v : allocated) {
+				if (v.first > 0) {
+					id_t v2 = v.first - 1;
+					mark_used(v2);
+					return v2;
+				} else if (v.second < std::numeric_limits<id_t>::max()) {
+					id_t v2 = v.second + 1;
+					mark_used(v2);
+					return v2;
+				}
+			}
+		} else {
+			mark_used(0);
+			return 0;
+		}
+		return std::numeric_limits<id_t>::max();
+	}
+
+	void free(id_t v) { mark_free(v); }
+
+private:
+	bool mark_used(id_t v)
+	{
+		if (allocated.size() == 0) {
+			allocated.push_back({v, v});
+			return true;
+		}
+
+		bool lastWasSmaller = false;
+		for (auto iter = allocated.begin(); iter != allocated.end(); iter++) {
+			auto fiter = std::list<range_t>::iterator(iter);
+			auto riter = std::list<range_t>::reverse_iterator(iter);
+			if ((iter->first > 0) && (v == (iter->first - 1))) {
+				iter->first--;
+				riter--;
+				if ((riter != allocated.rend()) && (riter->second == (v - 1))) {
+					riter->second = iter->second;
+					allocated.erase(iter);
+				}
+				return true;
+			} else if ((iter->second < std::numeric_limits<id_t>::max()) && (v == (iter->second + 1))) {
+				iter->second++;
+				fiter++;
+				if ((fiter != allocated.end()) && (fiter->first == (v + 1))) {
+					iter->second = fiter->second;
+					allocated.erase(fiter);
+				}
+				return true;
+			} else if (lastWasSmaller && (v < iter->first)) {
+				allocated.insert(iter, {v, v});
+				return true;
+			} else if ((fiter++) == allocated.end()) {
+				allocated.insert(fiter, {v, v});
+				return true;
+			}
+			lastWasSmaller = (v > iter->second);
+		}
+		return false;
+	}
+
+	bool mark_free(id_t v)
+	{
+		for (auto iter = allocated.begin(); iter != allocated.end(); iter++) {
+			if ((v >= iter->first) && (v <= iter->second)) {
+				if (v == iter->first) {
+					iter->first++;
+					if (iter->first > iter->second)
+						allocated.erase(iter);
+				} else if (v == iter->second) {
+					iter->second--;
+					if (iter->second < iter->first)
+						allocated.erase(iter);
+				} else {
+					range_t x{iter->first, v - 1};
+					iter->first = v + 1;
+					allocated.insert(iter, x);
+				}
+				return true;
+			}
+		}
+		return false;
+	}
+
+	std::list<range_t> allocated;
+};
+
+template<typename Allocator> static double run_churn(size_t live, size_t iterations, uint32_t seed)
+{
+	Allocator allocator;
+	std::vector<uint64_t> ids;
+	ids.reserve(live);
+	for (size_t idx = 0; idx < live; idx++)
+		ids.push_back(allocator.allocate());
+
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<size_t> pick(0, live - 1);
+
+	auto start = std::chrono::steady_clock::now();
+	for (size_t idx = 0; idx < iterations; idx++) {
+		size_t slot = pick(rng);
+		allocator.free(ids[slot]);
+		ids[slot] = allocator.allocate();
+	}
+	auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return iterations / elapsed;
+}
+
+template<typename Allocator> static double run_bulk(size_t live, size_t iterations, uint32_t seed)
+{
+	Allocator allocator;
+	std::vector<uint64_t> ids;
+	ids.reserve(live);
+	for (size_t idx = 0; idx < live; idx++)
+		ids.push_back(allocator.allocate());
+
+	std::mt19937 rng(seed);
+
+	size_t operations = 0;
+	auto start = std::chrono::steady_clock::now();
+	while (operations < iterations) {
+		std::shuffle(ids.begin(), ids.end(), rng);
+		size_t half = live / 2 + 1;
+		for (size_t idx = 0; idx < half; idx++)
+			allocator.free(ids[idx]);
+		for (size_t idx = 0; idx < half; idx++)
+			ids[idx] = allocator.allocate();
+		operations += half;
+	}
+	auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return operations / elapsed;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t live = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+	size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+	if (!live || !iterations) {
+		std::fprintf(stderr, "usage: %s [live ids] [iterations]\n", argv[0]);
+		return 1;
+	}
+
+	std::printf("live ids: %zu, iterations: %zu\n", live, iterations);
+
+	double legacy = run_churn<legacy_unique_id>(live, iterations, 1);
+	double current = run_churn<utility::unique_id>(live, iterations, 1);
+	std::printf("replace one, range list : %12.0f free+allocate/s\n", legacy);
+	std::printf("replace one, slot queue : %12.0f free+allocate/s (x%.1f)\n", current, current / legacy);
+
+	legacy = run_bulk<legacy_unique_id>(live, iterations, 1);
+	current = run_bulk<utility::unique_id>(live, iterations, 1);
+	std::printf("bulk half,   range list : %12.0f free+allocate/s\n", legacy);
+	std::printf("bulk half,   slot queue : %12.0f free+allocate/s (x%.1f)\n", current, current / legacy);
+	return 0;
+}